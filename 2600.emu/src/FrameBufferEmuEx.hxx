@@ -8,6 +8,7 @@
 #include <stella/emucore/EventHandlerConstants.hxx>
 #include <stella/common/PaletteHandler.hxx>
 #include <stella/common/VideoModeHandler.hxx>
+#include <emuframework/IndexedPalette.hh>
 #include <array>
 
 class Console;
@@ -107,8 +108,7 @@ public:
 private:
 	EmuEx::EmuApp *appPtr{};
 	PaletteHandler myPaletteHandler;
-	uInt16 tiaColorMap16[256]{};
-	uInt32 tiaColorMap32[256]{};
+	EmuEx::IndexedPalette tiaPalette;
 	uInt8 myPhosphorPalette[256][256]{};
 	std::array<uInt8, 160 * TIAConstants::frameBufferHeight> prevFramebuffer{};
 	Common::Rect myImageRect{};
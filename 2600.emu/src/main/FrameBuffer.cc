@@ -61,14 +61,13 @@ uint8_t FrameBuffer::getPhosphor(uInt8 c1, uInt8 c2) const
 void FrameBuffer::setTIAPalette(const PaletteArray& palette)
 {
 	logMsg("setTIAPalette");
-	auto desc32 = format == IG::PixelFmtBGRA8888 ? IG::PixelDescBGRA8888Native : IG::PixelDescRGBA8888Native;
+	tiaPalette.setFormat(format);
 	for(auto i : IG::iotaCount(256))
 	{
 		uint8_t r = (palette[i] >> 16) & 0xff;
 		uint8_t g = (palette[i] >> 8) & 0xff;
 		uint8_t b = palette[i] & 0xff;
-		tiaColorMap16[i] = IG::PixelDescRGB565.build(r >> 3, g >> 2, b >> 3, 0);
-		tiaColorMap32[i] = desc32.build((int)r, (int)g, (int)b, 0);
+		tiaPalette.setColor(i, r, g, b);
 	}
 }
 
@@ -120,28 +119,18 @@ void FrameBuffer::renderOutput(IG::MutablePixmapView pix, TIA &tia)
 			{
 				if constexpr(outputBits == 16)
 				{
-					return getRGBPhosphor16(tiaColorMap32[p], tiaColorMap32[*prevFrame++]);
+					return getRGBPhosphor16(tiaPalette.color32(p), tiaPalette.color32(*prevFrame++));
 				}
 				else
 				{
-					return getRGBPhosphor32(tiaColorMap32[p], tiaColorMap32[*prevFrame++]);
+					return getRGBPhosphor32(tiaPalette.color32(p), tiaPalette.color32(*prevFrame++));
 				}
 			}, framePix);
 		memcpy(prevFramebuffer.data(), tia.frameBuffer(), sizeof(prevFramebuffer));
 	}
 	else
 	{
-		pix.writeTransformed([this](uint8_t p)
-			{
-				if constexpr(outputBits == 16)
-				{
-					return tiaColorMap16[p];
-				}
-				else
-				{
-					return tiaColorMap32[p];
-				}
-			}, framePix);
+		tiaPalette.write(pix, framePix);
 	}
 }
 
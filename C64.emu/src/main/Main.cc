@@ -73,6 +73,7 @@ bool EmuSystem::hasResetModes = true;
 bool EmuSystem::handlesGenericIO = false;
 bool EmuSystem::hasRectangularPixels = true;
 bool EmuSystem::stateSizeChangesAtRuntime = true;
+bool EmuSystem::skipsUnchangedVideoRows = true;
 bool EmuApp::needsGlobalInstance = true;
 bool EmuApp::handlesRecentContent = true;
 
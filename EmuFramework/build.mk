@@ -1,8 +1,11 @@
 include $(IMAGINE_PATH)/make/imagineStaticLibBase.mk
 
 SRC += \
+ArchiveCache.cc \
 AssetManager.cc \
+AudioResampler.cc \
 AutosaveManager.cc \
+AVCapture.cc \
 ConfigFile.cc \
 EmuApp.cc \
 EmuAudio.cc \
@@ -13,6 +16,8 @@ EmuSystemTask.cc \
 EmuTiming.cc \
 EmuVideo.cc \
 EmuVideoLayer.cc \
+FrameTrace.cc \
+IndexedPalette.cc \
 InputDeviceConfig.cc \
 InputDeviceData.cc \
 KeyConfig.cc \
@@ -20,6 +25,8 @@ OutputTimingManager.cc \
 pathUtils.cc \
 RecentContent.cc \
 RewindManager.cc \
+ScreenshotWriter.cc \
+StateCodec.cc \
 ToggleInput.cc \
 TurboInput.cc \
 VideoImageEffect.cc \
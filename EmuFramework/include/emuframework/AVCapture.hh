@@ -0,0 +1,87 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/MemPixmap.hh>
+#include <imagine/audio/Format.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/container/RingBuffer.hh>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Streams raw video frames and PCM audio to disk from a writer thread.
+// Video goes to a simple frame stream (see AVCapture.cc for the layout) and audio to a WAV file.
+// Frames or audio that don't fit in the bounded queues are counted as dropped instead of blocking.
+class AVCapture
+{
+public:
+	static constexpr size_t maxPendingFrames = 8;
+
+	struct Stats
+	{
+		uint32_t frames{};
+		uint32_t droppedFrames{};
+		uint64_t audioFrames{};
+		uint64_t droppedAudioFrames{};
+	};
+
+	AVCapture() = default;
+	~AVCapture() { stop(); }
+	void start(FileIO videoIO, FileIO audioIO, SteadyClockDuration frameDuration, Audio::Format);
+	Stats stop();
+	bool isActive() const { return active.load(std::memory_order_relaxed); }
+	void addFrame(PixmapView);
+	void addAudio(const void *samples, size_t frames);
+
+private:
+	struct Frame
+	{
+		MemPixmap pix;
+		uint32_t number{};
+		SteadyClockDuration time{};
+	};
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::deque<Frame> frames;
+	std::vector<MemPixmap> freePixmaps;
+	size_t allocatedPixmaps{};
+	RingBuffer<uint8_t, RingBufferConf{.mirrored = true}> audioBuff;
+	FileIO videoIO;
+	FileIO audioIO;
+	Audio::Format audioFormat;
+	SteadyClockTimePoint startTime;
+	Stats stats;
+	std::atomic_bool active{};
+	bool quit{};
+
+	MemPixmap takePixmap(PixmapDesc);
+	void run();
+	void writeAudio();
+};
+
+}
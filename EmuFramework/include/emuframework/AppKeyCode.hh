@@ -46,6 +46,8 @@ enum class AppKeyCode : KeyCode
 	hardReset,
 	resetMenu,
 	closeContent,
+	takeBurstScreenshot,
+	toggleAVCapture,
 };
 
 constexpr struct AppKeys
@@ -65,6 +67,8 @@ constexpr struct AppKeys
 	toggleSlowMotion = KeyInfo::appKey(AppKeyCode::toggleSlowMotion),
 	rewind = KeyInfo::appKey(AppKeyCode::rewind),
 	takeScreenshot = KeyInfo::appKey(AppKeyCode::takeScreenshot),
+	takeBurstScreenshot = KeyInfo::appKey(AppKeyCode::takeBurstScreenshot),
+	toggleAVCapture = KeyInfo::appKey(AppKeyCode::toggleAVCapture),
 	turboModifier = KeyInfo::appKey(AppKeyCode::turboModifier),
 	softReset = KeyInfo::appKey(AppKeyCode::softReset),
 	hardReset = KeyInfo::appKey(AppKeyCode::hardReset),
@@ -0,0 +1,59 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/io/ArchiveIO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/time/Time.hh>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// On-disk cache of extracted archive entries, keyed by the archive's path, size,
+// modification time and the entry's name, size and CRC. Hits are opened memory mapped
+// and the least recently used entries are deleted once the total size exceeds maxBytes.
+// Small entries are cheap to decompress again so the minimum cached size depends on the
+// entry's decompression cost, stored entries are only cached when large enough to benefit from mapping.
+class ArchiveCache
+{
+public:
+	static constexpr std::uintmax_t defaultMaxBytes = 1024 * 1024 * 1024;
+	static constexpr std::uintmax_t minSolidEntryBytes = 256 * 1024;
+	static constexpr std::uintmax_t minEntryBytes = 1024 * 1024;
+	static constexpr std::uintmax_t minStoredEntryBytes = 16 * 1024 * 1024;
+
+	std::uintmax_t maxBytes{defaultMaxBytes};
+
+	ArchiveCache(ApplicationContext ctx): ctx{ctx} {}
+	bool canCache(ArchiveIO &entry) const;
+	// Returns an empty FileIO without reading the entry if it can't be cached,
+	// throws std::runtime_error if extraction fails after the entry has been read
+	FileIO openEntry(CStringView archivePath, size_t archiveSize, ArchiveIO &entry, IOAccessHint = IOAccessHint::All);
+	void clear();
+
+private:
+	ApplicationContext ctx;
+
+	FS::PathString cacheDirectory() const;
+	void evict(std::uintmax_t keepBytes);
+};
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/Format.hh>
+#include <array>
+#include <cmath>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Cubic (Catmull-Rom) resampler for int16/float mono/stereo frames that keeps its
+// fractional position and last input frames between calls so the ratio can change
+// every write without discontinuities
+class AudioResampler
+{
+public:
+	static constexpr int maxChannels = 2;
+
+	void reset();
+	// Consumes all source frames and writes up to destFrames, returning the number written.
+	// The ratio is source frames per destination frame.
+	size_t resample(void *dest, size_t destFrames, const void *src, size_t srcFrames, double ratio, Audio::Format);
+
+	static size_t maxOutputFrames(size_t srcFrames, double ratio)
+	{
+		return std::ceil(srcFrames / ratio) + 1;
+	}
+
+protected:
+	static constexpr int historyFrames = 3;
+	std::array<std::array<float, maxChannels>, historyFrames> history{};
+	double pos{};
+	bool primed{};
+
+	template<class T, int channels>
+	size_t resample(T *dest, size_t destFrames, const T *src, size_t srcFrames, double ratio);
+};
+
+}
@@ -16,13 +16,20 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <emuframework/config.hh>
+#include <emuframework/EmuSystem.hh>
 #include <imagine/base/PausableTimer.hh>
 #include <imagine/fs/FSDefs.hh>
 #include <imagine/io/FileIO.hh>
 #include <imagine/util/enum.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <functional>
+#include <thread>
 
 namespace EmuEx
 {
@@ -49,6 +56,7 @@ class AutosaveManager
 {
 public:
 	AutosaveManager(EmuApp &);
+	~AutosaveManager();
 	bool save(AutosaveActionSource src = AutosaveActionSource::Auto);
 	bool load(AutosaveActionSource src, LoadAutosaveMode m);
 	bool load(LoadAutosaveMode m) { return load(AutosaveActionSource::Auto, m); }
@@ -56,10 +64,12 @@ public:
 	bool setSlot(std::string_view name);
 	void resetSlot(std::string_view name = "")
 	{
+		waitForPendingSave();
 		autoSaveSlot = name;
 		saveTimer.cancel();
-		stateIO = {};
 	}
+	void waitForPendingSave();
+	void queueStateFileWrite(FS::PathString path, CapturedState, bool notify);
 	bool renameSlot(std::string_view name, std::string_view newName);
 	bool deleteSlot(std::string_view name);
 	std::string_view slotName() const { return autoSaveSlot; }
@@ -80,12 +90,32 @@ public:
 	auto& system(this auto&& self) { return self.app.system(); }
 
 private:
+	struct StateWrite
+	{
+		DynArray<uint8_t> state;
+		size_t size{};
+		FS::PathString path;
+		bool needsCompression{};
+		bool notify{};
+	};
+
 	EmuApp &app;
 	std::string autoSaveSlot;
-	FileIO stateIO;
+	// states are captured with emulation paused then compressed and written on ioThread
+	std::thread ioThread;
+	std::mutex ioMutex;
+	std::condition_variable ioCond;
+	std::optional<StateWrite> pendingWrite; // autosave, replaced by a newer one if not yet written
+	std::deque<StateWrite> queuedWrites; // slot saves, all written in order
+	DynArray<uint8_t> freeStateBuff;
+	bool ioBusy{};
+	bool ioQuit{};
 
 	bool saveState();
-	bool loadState();
+	bool loadState(FileIO &);
+	void startIO();
+	void runIO();
+	bool writeStateFile(CStringView path, std::span<const uint8_t> state, bool needsCompression);
 
 public:
 	PausableTimer<Minutes> saveTimer;
@@ -26,6 +26,10 @@
 #include <emuframework/AutosaveManager.hh>
 #include <emuframework/RecentContent.hh>
 #include <emuframework/RewindManager.hh>
+#include <emuframework/FrameTrace.hh>
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/AVCapture.hh>
+#include <emuframework/ArchiveCache.hh>
 #include <emuframework/AssetManager.hh>
 #include <imagine/input/inputDefs.hh>
 #include <imagine/input/android/MogaManager.hh>
@@ -132,7 +136,7 @@ public:
 
 	void mainInitCommon(IG::ApplicationInitParams, IG::ApplicationContext);
 	static void onCustomizeNavView(NavView &v);
-	void createSystemWithMedia(IG::IO, CStringView path, std::string_view displayName,
+	bool createSystemWithMedia(IG::IO, CStringView path, std::string_view displayName,
 		const Input::Event &, EmuSystemCreateParams, ViewAttachParams, CreateSystemCompleteDelegate);
 	void closeSystem();
 	void closeSystemWithoutSave();
@@ -178,6 +182,7 @@ public:
 	void saveSessionOptions();
 	void loadSessionOptions();
 	bool hasSavedSessionOptions();
+	bool isRunningCommandBenchmark() const { return commandBenchmark.frames; }
 	void resetSessionOptions();
 	void deleteSessionOptions();
 	[[nodiscard]]
@@ -212,8 +217,11 @@ public:
 	IG::Viewport makeViewport(const Window &win) const;
 	void setEmuViewOnExtraWindow(bool on, IG::Screen &);
 	void record(FrameTimingStatEvent, SteadyClockTimePoint t = {});
+	bool exportFrameTrace();
+	void setAVCapture(bool on);
 	static std::u16string_view mainViewName();
 	void runBenchmarkOneShot(EmuVideo &);
+	void runBenchmarkFromCommand(CStringView path);
 	void onSelectFileFromPicker(IG::IO, CStringView path, std::string_view displayName,
 		const Input::Event &, EmuSystemCreateParams, ViewAttachParams);
 	void handleOpenFileCommand(CStringView path);
@@ -335,14 +343,18 @@ public:
 	AutosaveManager autosaveManager{*this};
 	InputManager inputManager;
 	RewindManager rewindManager{*this};
+	FrameTrace frameTrace;
 	AssetManager assetManager;
 	FrameTimingStats frameTimingStats;
 	OutputTimingManager outputTimingManager;
 	EmuSystemTask systemTask{*this};
+	ScreenshotWriter screenshotWriter{*this};
+	AVCapture avCapture;
 	[[no_unique_address]] IG::VibrationManager vibrationManager;
 	DrawableConfig windowDrawableConfig;
 	BluetoothAdapter bluetoothAdapter;
 	RecentContent recentContent;
+	ArchiveCache archiveCache;
 	FS::PathString contentSearchPath;
 	std::string userScreenshotPath;
 	Property<IG::PixelFormat, CFGKEY_RENDER_PIXEL_FORMAT,
@@ -357,6 +369,7 @@ public:
 		.isValid = isValidFontSize
 	}> fontSize;
 	Property<int8_t, CFGKEY_FRAME_INTERVAL, {.defaultValue = 1, .isValid = isValidFrameInterval}> frameInterval;
+	Property<int8_t, CFGKEY_RUN_AHEAD_FRAMES, {.defaultValue = 0, .isValid = isValidRunAheadFrames}> runAheadFrames;
 	ConditionalProperty<Config::envIsAndroid, bool, CFGKEY_NOTIFICATION_ICON, {.defaultValue = true, .mutableDefault = true}> showsNotificationIcon;
 	ConditionalProperty<CAN_HIDE_TITLE_BAR, bool, CFGKEY_TITLE_BAR, {.defaultValue = true}> showsTitleBar;
 	ConditionalProperty<Config::NAVIGATION_BAR, InEmuTristate, CFGKEY_LOW_PROFILE_OS_NAV, {.defaultValue = InEmuTristate::InEmu}> lowProfileOSNav;
@@ -402,13 +415,21 @@ protected:
 		Gfx::DrawableConfig windowDrawableConf;
 	};
 
+	struct CommandBenchmark
+	{
+		int frames{};
+		bool withoutVideo{};
+	};
+
 	[[no_unique_address]] IG::Data::PixmapWriter pixmapWriter;
 	[[no_unique_address]] PerformanceHintManager perfHintManager;
 	[[no_unique_address]] PerformanceHintSession perfHintSession;
 	ConditionalMember<MOGA_INPUT, std::unique_ptr<Input::MogaManager>> mogaManagerPtr;
 	ConditionalMember<Config::TRANSLUCENT_SYSTEM_UI, bool> layoutBehindSystemUI{};
+	CommandBenchmark commandBenchmark;
 
 	void onMainWindowCreated(ViewAttachParams, const Input::Event &);
+	const char *parseCommandArgs(IG::CommandArgs);
 	ConfigParams loadConfigFile(IG::ApplicationContext);
 	void saveConfigFile(IG::ApplicationContext);
 	void saveConfigFile(FileIO &);
@@ -16,6 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <emuframework/EmuOptions.hh>
+#include <emuframework/AudioResampler.hh>
 #include <imagine/audio/OutputStream.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/time/Time.hh>
@@ -33,6 +34,8 @@ class FileIO;
 namespace EmuEx
 {
 
+class AVCapture;
+
 using namespace IG;
 
 struct AudioStats
@@ -96,8 +99,10 @@ public:
 protected:
 	IG::Audio::OutputStream audioStream;
 	RingBuffer<uint8_t, RingBufferConf{.mirrored = true}> rBuff;
+	AudioResampler resampler;
 	SteadyClockTimePoint lastUnderrunTime{};
 	double speedMultiplier{1.};
+	double avgBufferFillBytes{};
 	size_t targetBufferFillBytes{};
 	size_t bufferIncrementBytes{};
 	int defaultRate;
@@ -105,22 +110,29 @@ protected:
 	float maxVolume_{1.};
 	float currentVolume{1.};
 	std::atomic<AudioWriteState> audioWriteState{AudioWriteState::BUFFER};
+	std::atomic_uint32_t underruns{};
 	int8_t channels{2};
 	AudioFlags flags{defaultAudioFlags};
 	ConditionalMember<IG::Audio::Config::MULTIPLE_SYSTEM_APIS, IG::Audio::Api> audioAPI{};
 	bool addSoundBuffersOnUnderrun{};
+	bool resamplerHasHistory{};
 public:
 	bool addSoundBuffersOnUnderrunSetting{};
+	bool dynamicRateControl{true};
+	AVCapture *avCapture{};
 	Property<int8_t, CFGKEY_SOUND_BUFFERS,
 		{.defaultValue = 2, .isValid = isValidWithMinMax<1, 7, int8_t>}> soundBuffers;
 
 	size_t framesFree() const;
 	size_t framesWritten() const;
 	size_t framesCapacity() const;
+	uint32_t takeUnderruns() { return underruns.exchange(0, std::memory_order_relaxed); }
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
 	void updateVolume();
 	void updateAddBuffersOnUnderrun();
+	double rateControlRatio();
+	AudioResampler &continuedResampler();
 };
 
 }
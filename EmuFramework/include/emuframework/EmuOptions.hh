@@ -85,6 +85,8 @@ enum { CFGKEY_SOUND = 0, CFGKEY_TOUCH_CONTROL_DISPLAY = 1,
 	CFGKEY_REWIND_STATES = 118, CFGKEY_REWIND_TIMER_SECS = 119,
 	CFGKEY_FRAME_CLOCK = 120, CFGKEY_INPUT_DEVICE_CONTENT_CONFIGS = 121,
 	CFGKEY_SHOW_FRAME_TIMING_STATS = 122, CFGKEY_OUTPUT_FRAME_RATE_MODE = 123,
+	CFGKEY_REWIND_FRAME_INTERVAL = 124, CFGKEY_RUN_AHEAD_FRAMES = 125,
+	CFGKEY_DYNAMIC_RATE_CONTROL = 126,
 	// 256+ is reserved
 };
 
@@ -131,6 +133,11 @@ constexpr bool isValidFrameInterval(const auto &v)
 	return v >= 0 && v <= 4;
 }
 
+constexpr bool isValidRunAheadFrames(const auto &v)
+{
+	return v >= 0 && v <= 4;
+}
+
 constexpr bool imageEffectPixelFormatIsValid(const auto &v)
 {
 	switch(v)
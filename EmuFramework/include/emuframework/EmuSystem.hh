@@ -150,6 +150,26 @@ struct SaveStateFlags
 	uint8_t uncompressed:1{};
 };
 
+// State captured for a file, large states are left uncompressed so
+// they can be compressed with the block codec after emulation resumes
+struct CapturedState
+{
+	DynArray<uint8_t> data;
+	bool needsCompression{};
+};
+
+struct BenchmarkResult
+{
+	int frames{};
+	SteadyClockDuration duration{};
+	SteadyClockDuration medianFrameTime{};
+	SteadyClockDuration p95FrameTime{};
+	SteadyClockDuration p99FrameTime{};
+	SteadyClockDuration maxFrameTime{};
+
+	double framesPerSecond() const { return frames / duration_cast<FloatSeconds>(duration).count(); }
+};
+
 class EmuSystem
 {
 public:
@@ -167,7 +187,8 @@ public:
 		FAILED,
 		OK,
 		SET,
-		UPDATE
+		UPDATE,
+		CANCELED
 	};
 
 	struct LoadProgressMessage
@@ -182,6 +203,7 @@ public:
 			intArg{intArg}, intArg2{intArg2}, intArg3{intArg3}, progress{progress} {}
 	};
 
+	// returns false once the user cancels loading, systems may poll it and abort by throwing
 	using OnLoadProgressDelegate = IG::DelegateFunc<bool(int pos, int max, const char *label)>;
 	using NameFilterFunc = bool(*)(std::string_view name);
 	using BackupMemoryDirtyFlags = uint8_t;
@@ -207,6 +229,8 @@ public:
 	static F2Size validFrameRateRange;
 	static bool hasRectangularPixels;
 	static bool stateSizeChangesAtRuntime;
+	// mostly static frames, worth comparing rows to upload only changed ones
+	static bool skipsUnchangedVideoRows;
 
 	EmuSystem(IG::ApplicationContext ctx): appCtx{ctx} {}
 
@@ -250,6 +274,7 @@ public:
 	void onOptionsLoaded();
 	void onSessionOptionsLoaded(EmuApp &);
 	bool resetSessionOptions(EmuApp &);
+	bool onRunAheadOrRewindChanged(EmuApp &); // returns true if the system must restart to apply the change
 	void savePathChanged();
 	bool shouldFastForward() const;
 	FS::FileString contentDisplayNameForPath(CStringView path) const;
@@ -274,6 +299,8 @@ public:
 	void loadState(EmuApp &, CStringView uri);
 	void saveState(CStringView uri);
 	DynArray<uint8_t> saveState();
+	CapturedState captureState();
+	static DynArray<uint8_t> packState(CapturedState);
 	DynArray<uint8_t> uncompressGzipState(std::span<uint8_t> buff, size_t expectedSize = 0);
 	bool stateExists(int slot) const;
 	static std::string_view stateSlotName(int slot);
@@ -365,7 +392,7 @@ public:
 	void loadContentFromPath(CStringView path, std::string_view displayName,
 		EmuSystemCreateParams, OnLoadProgressDelegate);
 	void loadContentFromFile(IG::IO, CStringView path, std::string_view displayName,
-		EmuSystemCreateParams, OnLoadProgressDelegate);
+		EmuSystemCreateParams, OnLoadProgressDelegate, bool canCacheArchiveEntry = false);
 	int updateAudioFramesPerVideoFrame();
 	FrameRate scaledFrameRate() const
 	{
@@ -382,7 +409,7 @@ public:
 	static double audioMixRate(int outputRate, FrameRate inputFrameRate, FrameRate outputFrameRate);
 	double audioMixRate(int outputRate, FrameRate outputFrameRate) const { return audioMixRate(outputRate, frameRate(), outputFrameRate); }
 	void configFrameRate(int outputRate, FrameDuration outputFrameDuration);
-	SteadyClockDuration benchmark(EmuVideo&);
+	BenchmarkResult benchmark(EmuVideo*, int frames = 180);
 	bool hasContent() const;
 	void resetFrameTiming();
 	void pause(EmuApp &);
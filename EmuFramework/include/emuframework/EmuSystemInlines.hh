@@ -158,6 +158,13 @@ bool EmuSystem::resetSessionOptions(EmuApp &app)
 	return {};
 }
 
+bool EmuSystem::onRunAheadOrRewindChanged(EmuApp &app)
+{
+	if(&MainSystem::onRunAheadOrRewindChanged != &EmuSystem::onRunAheadOrRewindChanged)
+		return static_cast<MainSystem*>(this)->onRunAheadOrRewindChanged(app);
+	return {};
+}
+
 void EmuSystem::onSessionOptionsLoaded(EmuApp &app)
 {
 	if(&MainSystem::onSessionOptionsLoaded != &EmuSystem::onSessionOptionsLoaded)
@@ -20,6 +20,7 @@
 #include <imagine/thread/Thread.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/util/variant.hh>
+#include <imagine/util/memory/DynArray.hh>
 #include <imagine/util/ScopeGuard.hh>
 #include <flat_map>
 
@@ -145,6 +146,7 @@ private:
 	FrameRateConfig frameRateConfig;
 	int savedAdvancedFrames{};
 	FrameRateDetector frameRateDetector;
+	DynArray<uint8_t> runAheadState;
 	ConditionalMember<Config::multipleScreenFrameRates, std::flat_map<SteadyClockDuration, FrameRate>> detectedFrameRateMap;
 public:
 	bool enableBlankFrameInsertion{};
@@ -168,6 +170,7 @@ private:
 	void calibrateScreenFrameRate(FrameRate);
 	void setWindowInternal(Window&);
 	void drawWindowNow();
+	void runFramesAhead(EmuVideo&, EmuAudio*, int frames, int aheadFrames);
 };
 
 }
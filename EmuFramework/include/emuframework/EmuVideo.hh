@@ -26,6 +26,7 @@ namespace EmuEx
 using namespace IG;
 class EmuVideo;
 class EmuSystem;
+class IndexedPalette;
 
 class [[nodiscard]] EmuVideoImage
 {
@@ -56,11 +57,12 @@ public:
 	EmuVideoImage startFrameWithFormat(EmuSystemTaskContext, IG::PixmapDesc);
 	void startFrameWithFormat(EmuSystemTaskContext, IG::PixmapView);
 	void startFrameWithAltFormat(EmuSystemTaskContext, IG::PixmapView);
+	void startIndexedFrame(EmuSystemTaskContext, IG::PixmapView indexedPix, IndexedPalette &);
 	void startUnchangedFrame(EmuSystemTaskContext);
 	void finishFrame(EmuSystemTaskContext, Gfx::LockedTextureBuffer);
 	void finishFrame(EmuSystemTaskContext, IG::PixmapView);
 	void clear();
-	void takeGameScreenshot();
+	void takeGameScreenshot(int frames = 1);
 	bool isExternalTexture() const;
 	Gfx::PixmapBufferTexture& image();
 	Gfx::Renderer& renderer() const;
@@ -81,11 +83,9 @@ protected:
 	Gfx::PixmapBufferTexture vidImg;
 	IG::PixelFormat renderFmt;
 	Gfx::TextureBufferMode bufferMode{};
-	bool screenshotNextFrame{};
 	Gfx::ColorSpace colSpace{Gfx::ColorSpace::LINEAR};
 	bool useLinearFilter{true};
 
-	void doScreenshot(EmuSystemTaskContext, IG::PixmapView);
 	void postFrameFinished(EmuSystemTaskContext);
 	Gfx::TextureSamplerConfig samplerConfig() const { return samplerConfigForLinearFilter(useLinearFilter); }
 
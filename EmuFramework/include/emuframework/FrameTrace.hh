@@ -0,0 +1,77 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuTiming.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <atomic>
+#include <string>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+struct FrameTraceEntry
+{
+	SteadyClockTimePoint startOfFrame{};
+	SteadyClockTimePoint startOfEmulation{};
+	SteadyClockTimePoint startOfVideoUpload{};
+	SteadyClockTimePoint waitForPresent{};
+	SteadyClockTimePoint endOfFrame{};
+	SteadyClockDuration videoUpload{};
+	uint32_t audioFramesBuffered{};
+	uint32_t audioUnderruns{};
+};
+
+// Ring buffer of per-frame timing written by the emulation thread, readers
+// see every entry committed before the count they load
+class FrameTrace
+{
+public:
+	static constexpr size_t defaultCapacity = 7200;
+
+	bool isEnabled() const { return entries.size(); }
+	void setEnabled(bool on, size_t capacity = defaultCapacity);
+	void record(FrameTimingStatEvent, SteadyClockTimePoint);
+	void recordVideoUpload(SteadyClockTimePoint start, SteadyClockTimePoint end);
+	// calls uploadFunc, also recording its duration when enabled
+	void traceVideoUpload(auto &&uploadFunc)
+	{
+		if(!isEnabled()) [[likely]]
+		{
+			uploadFunc();
+			return;
+		}
+		auto start = SteadyClock::now();
+		uploadFunc();
+		recordVideoUpload(start, SteadyClock::now());
+	}
+	void commitFrame(uint32_t audioFramesBuffered, uint32_t audioUnderruns);
+	size_t size() const;
+	std::string toCSV() const;
+	std::string toChromeTrace() const;
+
+private:
+	DynArray<FrameTraceEntry> entries;
+	FrameTraceEntry pending;
+	std::atomic_size_t committed{};
+
+	void forEachEntry(auto &&func) const;
+};
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+#include <array>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// 256 color palette for systems that output 8-bit indexed frames. Colors are kept in
+// both RGB565 and the 32-bit render format so write() can expand a frame into either.
+class IndexedPalette
+{
+public:
+	IndexedPalette() = default;
+	void setFormat(PixelFormat);
+	PixelFormat format() const { return fmt; }
+	void setColor(uint8_t idx, uint8_t r, uint8_t g, uint8_t b);
+	uint16_t color16(uint8_t idx) const { return col16[idx]; }
+	uint32_t color32(uint8_t idx) const { return col32[idx]; }
+	void write(MutablePixmapView dest, PixmapView indexedSrc);
+
+private:
+	std::array<uint16_t, 256> col16{};
+	std::array<uint32_t, 256> col32{};
+	PixelFormat fmt{PixelFmtRGB565};
+
+	template<class T>
+	static void writeLine(T *dest, const uint8_t *src, int pixels, const std::array<T, 256> &col);
+};
+
+}
@@ -19,6 +19,7 @@
 #include <emuframework/EmuAppHelper.hh>
 #include <imagine/base/MessagePort.hh>
 #include <imagine/gfx/Quads.hh>
+#include <atomic>
 
 namespace EmuEx
 {
@@ -35,8 +36,11 @@ public:
 	void setPos(int val);
 	void setLabel(UTF16Convertible auto &&label) { text.resetString(IG_forward(label)); }
 	void place() final;
+	bool inputEvent(const Input::Event &, ViewInputEventParams p = {}) final;
 	void draw(Gfx::RendererCommands&__restrict__, ViewDrawParams p = {}) const final;
 	MessagePortType &messagePort();
+	// set from the UI thread when the user backs out, polled by the loader thread
+	bool isCanceled() const { return canceled.load(std::memory_order_relaxed); }
 
 private:
 	MessagePortType msgPort{"LoadProgressView"};
@@ -45,6 +49,7 @@ private:
 	Gfx::IQuads progessBarQuads;
 	Input::Event originalEvent;
 	int pos{}, max{1};
+	std::atomic_bool canceled{};
 
 	void updateProgressRect();
 };
@@ -17,7 +17,11 @@
 
 #include <emuframework/config.hh>
 #include <imagine/base/PausableTimer.hh>
-#include <imagine/util/memory/FlexArray.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/thread/Semaphore.hh>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace IG
 {
@@ -31,17 +35,22 @@ namespace EmuEx
 using namespace IG;
 
 class EmuApp;
+class EmuSystem;
 
 class RewindManager
 {
 public:
 	RewindManager(EmuApp &);
+	~RewindManager();
 	void clear();
 	bool reset();
 	void rewindState(EmuApp &);
+	bool stepBack(EmuApp &);
+	void onFramesAdvanced(EmuSystem &, int frames);
 	void startTimer();
 	void pauseTimer();
 	void resetTimer();
+	void setFrameInterval(uint8_t); // only call with emulation suspended
 	bool readConfig(MapIO &, unsigned key);
 	void writeConfig(FileIO &) const;
 
@@ -57,22 +66,43 @@ public:
 		return reset();
 	}
 
-private:
-	struct StateEntry
-	{
-		size_t size{};
-		uint8_t data[];
-	};
+	size_t deltaBytes() const;
 
-	FlexArray<StateEntry> stateEntries;
-	size_t stateIdx{};
+private:
+	// Only the newest state is stored in full, older states are kept as
+	// compressed XOR deltas that each lead back to the state saved before it
+	using StateWord = uint64_t;
+	DynArray<StateWord> lastState;
+	DynArray<StateWord> pendingState;
+	DynArray<uint8_t> deltaBuff;
+	std::vector<DynArray<uint8_t>> deltas;
+	size_t lastStateSize{};
+	size_t pendingStateSize{};
+	size_t deltaIdx{};
+	size_t deltaCount{};
+	// with a frame interval deltas are encoded on this thread so capturing on the
+	// emulation thread only costs the system's writeState()
+	std::thread deltaThread;
+	std::binary_semaphore deltaWorkSem{0};
+	std::atomic_bool deltaWorkPending{};
+	bool deltaThreadQuit{};
+	int framesSinceSave{};
 public:
 	size_t stateSize{};
 	size_t maxStates{};
+	uint8_t frameInterval{}; // if non-zero, save a state every N frames from the emulation thread instead of the timer, change with setFrameInterval()
+	std::atomic_bool isRewinding{}; // set from the UI thread while holding rewind with a frame interval
 	PausableTimer<Seconds> saveTimer;
 
 private:
 	void saveState(EmuApp &);
+	void captureState(EmuSystem &);
+	void commitPendingState();
+	void pushDelta(std::span<const uint8_t>);
+	std::span<uint8_t> popState(bool keepOldest);
+	void startDeltaThread();
+	void stopDeltaThread();
+	void waitForDeltaThread();
 };
 
 }
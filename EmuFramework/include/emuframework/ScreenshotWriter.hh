@@ -0,0 +1,72 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/MemPixmap.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+// Copies captured frames into pooled buffers and encodes them on a worker thread
+class ScreenshotWriter
+{
+public:
+	static constexpr size_t maxPendingFrames = 8;
+	static constexpr int burstFrames = 60;
+
+	ScreenshotWriter(EmuApp &app): app{app} {}
+	~ScreenshotWriter();
+	void request(int frames = 1);
+	bool isPending() const { return framesLeft.load(std::memory_order_relaxed); }
+	void capture(PixmapView);
+
+private:
+	struct Job
+	{
+		MemPixmap pix;
+		FS::PathString path;
+		bool isLast{};
+	};
+
+	EmuApp &app;
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable jobCond;
+	std::deque<Job> jobs;
+	std::vector<MemPixmap> freePixmaps;
+	size_t allocatedPixmaps{};
+	FS::PathString basePath;
+	std::atomic_int framesLeft{};
+	int frameIdx{};
+	bool hadError{};
+	bool quit{};
+
+	MemPixmap takePixmap(PixmapDesc);
+	void run();
+};
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/util/memory/DynArray.hh>
+#include <cstdint>
+#include <span>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Block based save state container: a header with the codec and a table of compressed block sizes,
+// followed by independently compressed blocks so both compression and decompression run in parallel.
+// Only state files use it, states under stateCodecMinSize keep the core's own format so older
+// versions can still load them. Files without the container header are passed to the core as-is.
+enum class StateCodec : uint8_t
+{
+	Deflate = 1,
+};
+
+constexpr size_t stateCodecBlockSize = 256 * 1024;
+constexpr size_t stateCodecMinSize = 2 * 1024 * 1024;
+
+bool hasStateCodecHeader(std::span<const uint8_t> buff);
+DynArray<uint8_t> compressState(std::span<const uint8_t> src, StateCodec codec = StateCodec::Deflate);
+DynArray<uint8_t> uncompressState(std::span<const uint8_t> buff);
+
+}
@@ -45,13 +45,15 @@ protected:
 	TextMenuItem rewindStatesItem[4];
 	MultiChoiceMenuItem rewindStates;
 	DualTextMenuItem rewindTimeInterval;
+	DualTextMenuItem rewindFrameInterval;
 	ConditionalMember<Config::envIsAndroid, BoolMenuItem> performanceMode;
 	ConditionalMember<Config::envIsAndroid && Config::DEBUG_BUILD, BoolMenuItem> noopThread;
 	ConditionalMember<Config::cpuAffinity, TextMenuItem> cpuAffinity;
+	TextMenuItem clearArchiveCache;
 	TextHeadingMenuItem autosaveHeading;
 	TextHeadingMenuItem rewindHeading;
 	TextHeadingMenuItem otherHeading;
-	StaticArrayList<MenuItem*, 33> item;
+	StaticArrayList<MenuItem*, 34> item;
 };
 
 }
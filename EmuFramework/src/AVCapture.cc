@@ -0,0 +1,226 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/AVCapture.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"AVCapture"};
+
+/*
+Video stream layout, all values little endian:
+File header: "EXAVCAP1", u64 frame duration in nanoseconds
+Per frame: u64 nanoseconds since capture start, u32 frame number, u16 width, u16 height,
+	u8 PixelFormatId, u8 bytes per pixel, 6 reserved bytes,
+	followed by width * height * bytes per pixel of packed pixel data
+Gaps in the frame number sequence are dropped frames.
+*/
+
+constexpr std::array<char, 8> videoMagic{'E', 'X', 'A', 'V', 'C', 'A', 'P', '1'};
+
+struct FrameHeader
+{
+	uint64_t timeNs;
+	uint32_t number;
+	uint16_t width;
+	uint16_t height;
+	uint8_t pixelFormat;
+	uint8_t bytesPerPixel;
+	uint8_t reserved[6]{};
+};
+
+static_assert(sizeof(FrameHeader) == 24);
+
+struct WavHeader
+{
+	char riff[4]{'R', 'I', 'F', 'F'};
+	uint32_t riffBytes;
+	char wave[4]{'W', 'A', 'V', 'E'};
+	char fmt[4]{'f', 'm', 't', ' '};
+	uint32_t fmtBytes{16};
+	uint16_t formatTag;
+	uint16_t channels;
+	uint32_t rate;
+	uint32_t byteRate;
+	uint16_t blockAlign;
+	uint16_t bitsPerSample;
+	char data[4]{'d', 'a', 't', 'a'};
+	uint32_t dataBytes;
+};
+
+static_assert(sizeof(WavHeader) == 44);
+
+static WavHeader makeWavHeader(Audio::Format format, uint64_t dataBytes)
+{
+	dataBytes = std::min(dataBytes, uint64_t(UINT32_MAX - 36));
+	return
+	{
+		.riffBytes = uint32_t(dataBytes + 36),
+		.formatTag = uint16_t(format.sample.isFloat() ? 3 : 1),
+		.channels = uint16_t(format.channels),
+		.rate = uint32_t(format.rate),
+		.byteRate = uint32_t(format.framesToBytes(format.rate)),
+		.blockAlign = uint16_t(format.bytesPerFrame()),
+		.bitsPerSample = uint16_t(format.sample.bits()),
+		.dataBytes = uint32_t(dataBytes),
+	};
+}
+
+void AVCapture::start(FileIO videoIO_, FileIO audioIO_, SteadyClockDuration frameDuration, Audio::Format format)
+{
+	stop();
+	videoIO = std::move(videoIO_);
+	audioIO = std::move(audioIO_);
+	audioFormat = format;
+	stats = {};
+	quit = false;
+	videoIO.write(videoMagic.data(), videoMagic.size());
+	videoIO.put(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(frameDuration).count()));
+	audioIO.put(makeWavHeader(format, 0));
+	// hold a second of audio so the writer thread can fall behind briefly
+	audioBuff.setMinCapacity(format.framesToBytes(size_t(format.rate)));
+	audioBuff.clear();
+	startTime = SteadyClock::now();
+	thread = std::thread{[this]{ run(); }};
+	active.store(true, std::memory_order_relaxed);
+	log.info("started capture");
+}
+
+AVCapture::Stats AVCapture::stop()
+{
+	if(!thread.joinable())
+		return stats;
+	active.store(false, std::memory_order_relaxed);
+	{
+		std::scoped_lock lock{mutex};
+		quit = true;
+	}
+	cond.notify_one();
+	thread.join();
+	writeAudio();
+	// fill in the final data size now that it's known
+	audioIO.put(makeWavHeader(audioFormat, audioFormat.framesToBytes(stats.audioFrames)), 0);
+	videoIO = {};
+	audioIO = {};
+	audioBuff.reset();
+	freePixmaps.clear();
+	allocatedPixmaps = 0;
+	log.info("stopped capture, {} frames ({} dropped), {} audio frames ({} dropped)",
+		stats.frames, stats.droppedFrames, stats.audioFrames, stats.droppedAudioFrames);
+	return stats;
+}
+
+MemPixmap AVCapture::takePixmap(PixmapDesc desc)
+{
+	if(freePixmaps.size())
+	{
+		auto pix = std::move(freePixmaps.back());
+		freePixmaps.pop_back();
+		if(pix.desc() != desc)
+			pix = {desc};
+		return pix;
+	}
+	if(allocatedPixmaps == maxPendingFrames)
+		return {};
+	allocatedPixmaps++;
+	return {desc};
+}
+
+void AVCapture::addFrame(PixmapView srcPix)
+{
+	auto number = stats.frames + stats.droppedFrames;
+	MemPixmap pix;
+	{
+		std::scoped_lock lock{mutex};
+		pix = takePixmap(srcPix.desc());
+	}
+	if(!pix)
+	{
+		stats.droppedFrames++;
+		return;
+	}
+	pix.view().write(srcPix);
+	stats.frames++;
+	{
+		std::scoped_lock lock{mutex};
+		frames.emplace_back(std::move(pix), number, SteadyClock::now() - startTime);
+	}
+	cond.notify_one();
+}
+
+void AVCapture::addAudio(const void *samples, size_t frameCount)
+{
+	auto bytes = audioFormat.framesToBytes(frameCount);
+	auto written = audioBuff.write({static_cast<const uint8_t*>(samples), bytes});
+	auto writtenFrames = audioFormat.bytesToFrames(written);
+	stats.audioFrames += writtenFrames;
+	stats.droppedAudioFrames += frameCount - writtenFrames;
+}
+
+void AVCapture::run()
+{
+	std::unique_lock lock{mutex};
+	while(true)
+	{
+		// audio doesn't signal, so wake periodically to drain it
+		cond.wait_for(lock, Milliseconds{50}, [&]{ return quit || frames.size(); });
+		lock.unlock();
+		writeAudio();
+		lock.lock();
+		if(frames.empty())
+		{
+			if(quit)
+				return;
+			continue;
+		}
+		auto frame = std::move(frames.front());
+		frames.pop_front();
+		lock.unlock();
+		auto pix = frame.pix.view();
+		FrameHeader header
+		{
+			.timeNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(frame.time).count()),
+			.number = frame.number,
+			.width = uint16_t(pix.w()),
+			.height = uint16_t(pix.h()),
+			.pixelFormat = uint8_t(PixelFormatId(pix.format())),
+			.bytesPerPixel = uint8_t(pix.format().bytesPerPixel()),
+		};
+		videoIO.put(header);
+		videoIO.write(pix.data(), pix.bytes());
+		lock.lock();
+		freePixmaps.emplace_back(std::move(frame.pix));
+	}
+}
+
+void AVCapture::writeAudio()
+{
+	while(true)
+	{
+		auto span = audioBuff.beginRead(audioBuff.size());
+		if(span.empty())
+			return;
+		audioIO.write(span.data(), span.size());
+		audioBuff.endRead(span);
+	}
+}
+
+}
@@ -0,0 +1,151 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/ArchiveCache.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ArchiveCache"};
+
+struct Fnv1aHash
+{
+	uint64_t value{0xcbf29ce484222325};
+
+	void add(std::string_view str)
+	{
+		for(auto c : str)
+		{
+			value = (value ^ uint8_t(c)) * 0x100000001b3;
+		}
+		add(uint64_t(str.size()));
+	}
+
+	void add(uint64_t v)
+	{
+		for(auto i : iotaCount(8))
+		{
+			value = (value ^ uint8_t(v >> (i * 8))) * 0x100000001b3;
+		}
+	}
+};
+
+FS::PathString ArchiveCache::cacheDirectory() const
+{
+	return FS::createDirectorySegments(ctx.cachePath(), "archives");
+}
+
+bool ArchiveCache::canCache(ArchiveIO &entry) const
+{
+	auto entrySize = entry.size();
+	if(entrySize > maxBytes)
+		return false;
+	if(entry.isStored())
+		return entrySize >= minStoredEntryBytes;
+	if(entry.isSolidFormat())
+		return entrySize >= minSolidEntryBytes;
+	return entrySize >= minEntryBytes;
+}
+
+FileIO ArchiveCache::openEntry(CStringView archivePath, size_t archiveSize, ArchiveIO &entry, IOAccessHint accessHint)
+{
+	if(!canCache(entry))
+		return {};
+	auto entrySize = entry.size();
+	Fnv1aHash hash;
+	hash.add(archivePath);
+	hash.add(archiveSize);
+	hash.add(ctx.fileUriLastWriteTime(archivePath).time_since_epoch().count());
+	hash.add(entry.name());
+	hash.add(entrySize);
+	hash.add(entry.crc32());
+	auto dir = cacheDirectory();
+	auto path = FS::pathString(dir, std::format("{:016x}", hash.value));
+	if(FS::file_size(path) == entrySize)
+	{
+		log.info("using cached entry:{} for {}", path, entry.name());
+		FS::touch(path);
+		return {path, {.test = true, .accessHint = accessHint}};
+	}
+	evict(maxBytes - entrySize);
+	auto tempPath = FS::PathString{path}.append(".tmp");
+	log.info("extracting {} to cache:{}", entry.name(), path);
+	{
+		FileIO tempFile{tempPath, OpenFlags::newFile()};
+		auto buff = dynArrayForOverwrite<uint8_t>(256 * 1024);
+		size_t bytesLeft = entrySize;
+		while(bytesLeft)
+		{
+			auto bytesRead = entry.read(buff.data(), std::min(bytesLeft, buff.size()));
+			if(bytesRead <= 0 || tempFile.write(buff.data(), bytesRead) != bytesRead)
+			{
+				tempFile = {};
+				FS::remove(tempPath);
+				throw std::runtime_error{std::format("Error extracting {} to cache", entry.name())};
+			}
+			bytesLeft -= bytesRead;
+		}
+	}
+	if(!FS::rename(tempPath, path))
+	{
+		FS::remove(tempPath);
+		throw std::runtime_error{std::format("Error moving {} into cache", entry.name())};
+	}
+	return {path, {.accessHint = accessHint}};
+}
+
+void ArchiveCache::evict(std::uintmax_t keepBytes)
+{
+	struct CacheFile
+	{
+		FS::PathString path;
+		FS::file_status status;
+	};
+	std::vector<CacheFile> files;
+	std::uintmax_t totalBytes{};
+	for(const auto &e : FS::directory_iterator{cacheDirectory()})
+	{
+		auto status = FS::status(e.path());
+		totalBytes += status.size();
+		files.emplace_back(e.path(), status);
+	}
+	if(totalBytes <= keepBytes)
+		return;
+	std::ranges::sort(files, {}, [](const auto &f){ return f.status.lastWriteTime(); });
+	for(const auto &f : files)
+	{
+		if(totalBytes <= keepBytes)
+			break;
+		log.info("evicting cached entry:{}", f.path);
+		if(FS::remove(f.path))
+			totalBytes -= f.status.size();
+	}
+}
+
+void ArchiveCache::clear()
+{
+	evict(0);
+}
+
+}
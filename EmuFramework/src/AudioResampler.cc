@@ -0,0 +1,271 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/AudioResampler.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/util/utility.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace EmuEx
+{
+
+template<class T>
+static float toFloat(T s) { return s; }
+
+template<class T>
+static T fromFloat(float s)
+{
+	if constexpr(std::is_floating_point_v<T>)
+		return s;
+	else
+	{
+		// truncating after adding 0.5 away from zero matches std::lround,
+		// the vector kernels below round the same way
+		s = std::clamp(s, float(INT16_MIN), float(INT16_MAX));
+		return static_cast<T>(s + std::copysign(.5f, s));
+	}
+}
+
+// Catmull-Rom spline through y1 and y2 at position t in [0, 1)
+static float cubic(float y0, float y1, float y2, float y3, float t)
+{
+	float a0 = -.5f * y0 + 1.5f * y1 - 1.5f * y2 + .5f * y3;
+	float a1 = y0 - 2.5f * y1 + 2.f * y2 - .5f * y3;
+	float a2 = -.5f * y0 + .5f * y2;
+	return ((a0 * t + a1) * t + a2) * t + y1;
+}
+
+// Vector kernels evaluate the spline for 4 output frames at once and return the number of frames written.
+// Each frame has its own position so the input points are gathered with scalar loads, they stop
+// when fewer than 4 frames fit or an input point is in the history, the scalar loop handles those.
+#if defined __SSE2__
+using FloatVec = __m128;
+static FloatVec loadVec(const float *p) { return _mm_loadu_ps(p); }
+static FloatVec addVec(FloatVec a, FloatVec b) { return _mm_add_ps(a, b); }
+static FloatVec mulVec(FloatVec a, FloatVec b) { return _mm_mul_ps(a, b); }
+static FloatVec mulVec(FloatVec a, float b) { return _mm_mul_ps(a, _mm_set1_ps(b)); }
+
+static __m128i roundToI32Lanes(__m128 s)
+{
+	// same mapping as fromFloat<int16_t>()
+	s = _mm_min_ps(_mm_max_ps(s, _mm_set1_ps(INT16_MIN)), _mm_set1_ps(INT16_MAX));
+	auto half = _mm_or_ps(_mm_and_ps(s, _mm_set1_ps(-0.f)), _mm_set1_ps(.5f));
+	return _mm_cvttps_epi32(_mm_add_ps(s, half));
+}
+
+static void storeFrames(float *dest, FloatVec s) { _mm_storeu_ps(dest, s); }
+
+static void storeFrames(float *dest, FloatVec l, FloatVec r)
+{
+	_mm_storeu_ps(dest, _mm_unpacklo_ps(l, r));
+	_mm_storeu_ps(dest + 4, _mm_unpackhi_ps(l, r));
+}
+
+static void storeFrames(int16_t *dest, FloatVec s)
+{
+	auto v = roundToI32Lanes(s);
+	_mm_storel_epi64((__m128i*)dest, _mm_packs_epi32(v, v));
+}
+
+static void storeFrames(int16_t *dest, FloatVec l, FloatVec r)
+{
+	auto lv = roundToI32Lanes(l);
+	auto rv = roundToI32Lanes(r);
+	_mm_storeu_si128((__m128i*)dest, _mm_packs_epi32(_mm_unpacklo_epi32(lv, rv), _mm_unpackhi_epi32(lv, rv)));
+}
+#elif defined __ARM_NEON
+using FloatVec = float32x4_t;
+static FloatVec loadVec(const float *p) { return vld1q_f32(p); }
+static FloatVec addVec(FloatVec a, FloatVec b) { return vaddq_f32(a, b); }
+static FloatVec mulVec(FloatVec a, FloatVec b) { return vmulq_f32(a, b); }
+static FloatVec mulVec(FloatVec a, float b) { return vmulq_n_f32(a, b); }
+
+static int16x4_t roundToI16Lanes(float32x4_t s)
+{
+	// same mapping as fromFloat<int16_t>()
+	s = vminq_f32(vmaxq_f32(s, vdupq_n_f32(INT16_MIN)), vdupq_n_f32(INT16_MAX));
+	auto half = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(s), vdupq_n_u32(0x80000000)),
+		vreinterpretq_u32_f32(vdupq_n_f32(.5f))));
+	return vqmovn_s32(vcvtq_s32_f32(vaddq_f32(s, half)));
+}
+
+static void storeFrames(float *dest, FloatVec s) { vst1q_f32(dest, s); }
+static void storeFrames(float *dest, FloatVec l, FloatVec r) { vst2q_f32(dest, float32x4x2_t{l, r}); }
+static void storeFrames(int16_t *dest, FloatVec s) { vst1_s16(dest, roundToI16Lanes(s)); }
+static void storeFrames(int16_t *dest, FloatVec l, FloatVec r) { vst2_s16(dest, int16x4x2_t{roundToI16Lanes(l), roundToI16Lanes(r)}); }
+#endif
+
+#if defined __SSE2__ || defined __ARM_NEON
+// same operation order as the scalar cubic()
+static FloatVec cubic(FloatVec y0, FloatVec y1, FloatVec y2, FloatVec y3, FloatVec t)
+{
+	auto a0 = addVec(addVec(addVec(mulVec(y0, -.5f), mulVec(y1, 1.5f)), mulVec(y2, -1.5f)), mulVec(y3, .5f));
+	auto a1 = addVec(addVec(addVec(y0, mulVec(y1, -2.5f)), mulVec(y2, 2.f)), mulVec(y3, -.5f));
+	auto a2 = addVec(mulVec(y0, -.5f), mulVec(y2, .5f));
+	return addVec(mulVec(addVec(mulVec(addVec(mulVec(a0, t), a1), t), a2), t), y1);
+}
+
+template<class T, int channels>
+static size_t resampleVec(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames,
+	double &pos, double ratio, size_t historyFrames)
+{
+	size_t written{};
+	while(destFrames - written >= 4)
+	{
+		double lanePos[4]{pos};
+		for(size_t i = 1; i < 4; i++) { lanePos[i] = lanePos[i - 1] + ratio; }
+		if(size_t(lanePos[0]) <= historyFrames || lanePos[3] >= srcFrames + 1)
+			break;
+		float y[4][channels][4];
+		float t[4];
+		for(auto lane : iotaCount(4))
+		{
+			auto idx = size_t(lanePos[lane]);
+			t[lane] = lanePos[lane] - idx;
+			auto s = &src[(idx - historyFrames - 1) * channels];
+			for(auto p : iotaCount(4))
+			{
+				for(auto ch : iotaCount(channels)) { y[p][ch][lane] = toFloat(s[p * channels + ch]); }
+			}
+		}
+		auto tVec = loadVec(t);
+		FloatVec out[channels];
+		for(auto ch : iotaCount(channels))
+		{
+			out[ch] = cubic(loadVec(y[0][ch]), loadVec(y[1][ch]), loadVec(y[2][ch]), loadVec(y[3][ch]), tVec);
+		}
+		if constexpr(channels == 1)
+			storeFrames(dest, out[0]);
+		else
+			storeFrames(dest, out[0], out[1]);
+		dest += 4 * channels;
+		written += 4;
+		pos = lanePos[3] + ratio;
+	}
+	return written;
+}
+#else
+template<class T, int channels>
+static size_t resampleVec(T*, size_t, const T*, size_t, double &, double, size_t) { return 0; }
+#endif
+
+void AudioResampler::reset()
+{
+	primed = false;
+}
+
+template<class T, int channels>
+size_t AudioResampler::resample(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames, double ratio)
+{
+	// Input frames are indexed as if the history preceded the source buffer:
+	// 0 to historyFrames - 1 are saved frames, historyFrames onward map to src
+	auto sample = [&](size_t idx, int ch) -> float
+	{
+		return idx < historyFrames ? history[idx][ch] : toFloat(src[(idx - historyFrames) * channels + ch]);
+	};
+	if(!primed)
+	{
+		for(auto &f : history)
+		{
+			for(auto ch : iotaCount(channels)) { f[ch] = toFloat(src[ch]); }
+		}
+		pos = historyFrames;
+		primed = true;
+	}
+	const size_t lastPos = srcFrames; // interpolation needs 2 frames past the position
+	size_t written{};
+	while(written < destFrames && pos < lastPos + 1)
+	{
+		if(auto frames = resampleVec<T, channels>(dest, destFrames - written, src, srcFrames, pos, ratio, historyFrames))
+		{
+			dest += frames * channels;
+			written += frames;
+			continue;
+		}
+		auto idx = size_t(pos);
+		float t = pos - idx;
+		if(idx > historyFrames)
+		{
+			// all points are in the source buffer, keep this path branch-free per channel
+			auto s = &src[(idx - historyFrames - 1) * channels];
+			for(auto ch : iotaCount(channels))
+			{
+				dest[ch] = fromFloat<T>(cubic(toFloat(s[ch]), toFloat(s[channels + ch]),
+					toFloat(s[channels * 2 + ch]), toFloat(s[channels * 3 + ch]), t));
+			}
+		}
+		else
+		{
+			for(auto ch : iotaCount(channels))
+			{
+				dest[ch] = fromFloat<T>(cubic(sample(idx - 1, ch), sample(idx, ch),
+					sample(idx + 1, ch), sample(idx + 2, ch), t));
+			}
+		}
+		dest += channels;
+		written++;
+		pos += ratio;
+	}
+	if(pos < lastPos + 1) // destination full, skip remaining output positions
+	{
+		pos += ratio * std::ceil((lastPos + 1 - pos) / ratio);
+	}
+	// shift the last input frames into the history for the next call
+	decltype(history) newHistory;
+	for(auto i : iotaCount(historyFrames))
+	{
+		for(auto ch : iotaCount(channels)) { newHistory[i][ch] = sample(srcFrames + i, ch); }
+	}
+	history = newHistory;
+	pos -= srcFrames;
+	return written;
+}
+
+size_t AudioResampler::resample(void *dest, size_t destFrames, const void *src, size_t srcFrames, double ratio, Audio::Format format)
+{
+	if(!srcFrames) [[unlikely]]
+		return 0;
+	assumeExpr(ratio > 0.);
+	if(format.channels == 1)
+	{
+		if(format.sample.isFloat())
+			return resample<float, 1>((float*)dest, destFrames, (const float*)src, srcFrames, ratio);
+		else
+			return resample<int16_t, 1>((int16_t*)dest, destFrames, (const int16_t*)src, srcFrames, ratio);
+	}
+	else
+	{
+		if(format.channels != 2)
+		{
+			bug_unreachable("channels == %d", format.channels);
+		}
+		if(format.sample.isFloat())
+			return resample<float, 2>((float*)dest, destFrames, (const float*)src, srcFrames, ratio);
+		else
+			return resample<int16_t, 2>((int16_t*)dest, destFrames, (const int16_t*)src, srcFrames, ratio);
+	}
+}
+
+}
@@ -17,9 +17,11 @@
 #include <emuframework/EmuApp.hh>
 #include <emuframework/Option.hh>
 #include <emuframework/EmuOptions.hh>
+#include <emuframework/StateCodec.hh>
 #include "pathUtils.hh"
 #include <imagine/io/MapIO.hh>
 #include <imagine/io/FileIO.hh>
+#include <imagine/util/format.hh>
 #include <imagine/logger/logger.h>
 
 namespace EmuEx
@@ -63,8 +65,8 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 		system().loadBackupMemory(app);
 		if(saveOnlyBackupMemory && src == AutosaveActionSource::Auto)
 			return true;
-		if(!stateIO)
-			stateIO = appContext().openFileUri(statePath(), OpenFlags::createFile());
+		waitForPendingSave();
+		auto stateIO = appContext().openFileUri(statePath(), OpenFlags::createFile());
 		if(stateIO.getExpected<uint8_t>(0)) // check if state contains data
 		{
 			if(mode == LoadAutosaveMode::NoState)
@@ -72,7 +74,7 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 				log.info("skipped loading autosave state");
 				return true;
 			}
-			return loadState();
+			return loadState(stateIO);
 		}
 		else
 		{
@@ -90,25 +92,168 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 	}
 }
 
+AutosaveManager::~AutosaveManager()
+{
+	if(!ioThread.joinable())
+		return;
+	{
+		std::scoped_lock lock{ioMutex};
+		ioQuit = true;
+	}
+	ioCond.notify_all();
+	ioThread.join();
+}
+
 bool AutosaveManager::saveState()
 {
 	log.info("saving autosave state");
-	stateIO.truncate(0);
-	auto state = app.saveState();
-	if(stateIO.write(state.span(), 0).bytes != ssize_t(state.size()))
+	StateWrite write{.path = statePath()};
+	{
+		std::scoped_lock lock{ioMutex};
+		write.state = std::move(freeStateBuff);
+	}
+	try
+	{
+		// only the size query and snapshot are done with emulation paused,
+		// some systems need to stop the CPU to report the state size
+		auto suspendCtx = app.suspendEmulationThread();
+		auto stateSize = system().stateSize();
+		if(write.state.size() < stateSize)
+			write.state = dynArrayForOverwrite<uint8_t>(stateSize);
+		write.needsCompression = stateSize >= stateCodecMinSize;
+		write.size = system().writeState(write.state, {.uncompressed = write.needsCompression});
+	}
+	catch(std::exception &err)
 	{
-		app.postErrorMessage(4, "Error writing autosave state");
+		app.postErrorMessage(4, std::format("Error saving autosave state:\n{}", err.what()));
 		return false;
 	}
+	startIO();
+	{
+		std::scoped_lock lock{ioMutex};
+		if(pendingWrite) // superseded by this state before being written
+			freeStateBuff = std::move(pendingWrite->state);
+		pendingWrite = std::move(write);
+	}
+	ioCond.notify_all();
 	return true;
 }
 
-bool AutosaveManager::loadState()
+void AutosaveManager::queueStateFileWrite(FS::PathString path, CapturedState state, bool notify)
+{
+	auto size = state.data.size();
+	startIO();
+	{
+		std::scoped_lock lock{ioMutex};
+		queuedWrites.emplace_back(std::move(state.data), size, std::move(path), state.needsCompression, notify);
+	}
+	ioCond.notify_all();
+}
+
+void AutosaveManager::waitForPendingSave()
+{
+	std::unique_lock lock{ioMutex};
+	ioCond.wait(lock, [&]{ return !pendingWrite && queuedWrites.empty() && !ioBusy; });
+}
+
+void AutosaveManager::startIO()
+{
+	if(!ioThread.joinable())
+	{
+		ioThread = std::thread{[this]{ runIO(); }};
+	}
+}
+
+void AutosaveManager::runIO()
+{
+	std::unique_lock lock{ioMutex};
+	while(true)
+	{
+		ioCond.wait(lock, [&]{ return ioQuit || pendingWrite || queuedWrites.size(); });
+		StateWrite write;
+		bool isAutosave{};
+		if(queuedWrites.size())
+		{
+			write = std::move(queuedWrites.front());
+			queuedWrites.pop_front();
+		}
+		else if(pendingWrite)
+		{
+			write = std::move(*pendingWrite);
+			pendingWrite.reset();
+			isAutosave = true;
+		}
+		else
+		{
+			return;
+		}
+		ioBusy = true;
+		lock.unlock();
+		bool success = writeStateFile(write.path, {write.state.data(), write.size}, write.needsCompression);
+		lock.lock();
+		if(isAutosave && write.state.size() > freeStateBuff.size())
+			freeStateBuff = std::move(write.state);
+		ioBusy = false;
+		ioCond.notify_all();
+		if(!success || write.notify)
+		{
+			app.runOnMainThread([&app = app, success, isAutosave](ApplicationContext)
+			{
+				if(success)
+					app.postMessage("State Saved");
+				else
+					app.postErrorMessage(4, isAutosave ? "Error writing autosave state" : "Error writing state");
+			});
+		}
+	}
+}
+
+// Writes to a temporary file that replaces the old state only after it's fully synced to storage
+bool AutosaveManager::writeStateFile(CStringView path, std::span<const uint8_t> state, bool needsCompression)
+{
+	auto ctx = appContext();
+	auto tmpPath = IG::format<FS::PathString>("{}.tmp", path);
+	try
+	{
+		DynArray<uint8_t> compState;
+		if(needsCompression)
+		{
+			compState = compressState(state);
+			state = compState.span();
+		}
+		{
+			auto file = ctx.openFileUri(tmpPath, OpenFlags::newFile());
+			if(file.write(state).bytes != ssize_t(state.size()))
+				throw std::runtime_error("Short write");
+			file.sync();
+		}
+		if(!ctx.renameFileUri(tmpPath, path))
+		{
+			// some URI providers can't rename over an existing file
+			ctx.removeFileUri(path);
+			if(!ctx.renameFileUri(tmpPath, path))
+				throw std::runtime_error("Can't rename temporary file");
+		}
+		return true;
+	}
+	catch(std::exception &err)
+	{
+		log.error("error writing state {}: {}", path, err.what());
+		ctx.removeFileUri(tmpPath);
+		return false;
+	}
+}
+
+bool AutosaveManager::loadState(FileIO &stateIO)
 {
 	log.info("loading autosave state");
 	try
 	{
-		app.readState(stateIO.buffer(IOBufferMode::Direct));
+		auto buff = stateIO.buffer(IOBufferMode::Direct);
+		if(hasStateCodecHeader(buff.span()))
+			app.readState(uncompressState(buff.span()));
+		else
+			app.readState(buff);
 		return true;
 	}
 	catch(std::exception &err)
@@ -135,6 +280,7 @@ bool AutosaveManager::setSlot(std::string_view name)
 
 bool AutosaveManager::renameSlot(std::string_view name, std::string_view newName)
 {
+	waitForPendingSave();
 	if(!appContext().renameFileUri(system().contentLocalSaveDirectory(name),
 		system().contentLocalSaveDirectory(newName)))
 	{
@@ -149,6 +295,7 @@ bool AutosaveManager::deleteSlot(std::string_view name)
 {
 	if(name == autoSaveSlot)
 		return false;
+	waitForPendingSave();
 	auto ctx = appContext();
 	if(!ctx.forEachInDirectoryUri(system().contentLocalSaveDirectory(name),
 		[ctx](const FS::directory_entry &e)
@@ -56,6 +56,7 @@ void EmuApp::saveConfigFile(FileIO &io)
 	writeOptionValueIfNotDefault(io, hidesStatusBar);
 	writeOptionValueIfNotDefault(io, showsBundledGames);
 	writeOptionValueIfNotDefault(io, frameInterval);
+	writeOptionValueIfNotDefault(io, runAheadFrames);
 	writeOptionValueIfNotDefault(io, frameClockSource);
 	writeOptionValueIfNotDefault(io, idleDisplayPowerSave);
 	writeOptionValueIfNotDefault(io, confirmOverwriteState);
@@ -176,6 +177,7 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 				case CFGKEY_RECENT_CONTENT_V2:
 					return handlesRecentContent ? system().readConfig(ConfigType::MAIN, io, key) : recentContent.readContent(io, system());
 				case CFGKEY_FRAME_INTERVAL: return readOptionValue(io, frameInterval);
+				case CFGKEY_RUN_AHEAD_FRAMES: return readOptionValue(io, runAheadFrames);
 				case CFGKEY_FRAME_RATE: return readOptionValue<FrameDuration>(io, [&](auto &&val){outputTimingManager.setFrameRateOption(VideoSystem::NATIVE_NTSC, val);});
 				case CFGKEY_FRAME_RATE_PAL: return readOptionValue<FrameDuration>(io, [&](auto &&val){outputTimingManager.setFrameRateOption(VideoSystem::PAL, val);});
 				case CFGKEY_LAST_DIR:
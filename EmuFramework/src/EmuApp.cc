@@ -51,6 +51,8 @@
 #include <imagine/bluetooth/BluetoothInputDevice.hh>
 #include <imagine/input/android/MogaManager.hh>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 namespace EmuEx
 {
@@ -72,6 +74,7 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	assetManager{ctx},
 	vibrationManager{ctx},
 	bluetoothAdapter{ctx},
+	archiveCache{ctx},
 	pixmapWriter{ctx},
 	perfHintManager{ctx.performanceHintManager()},
 	layoutBehindSystemUI{ctx.hasTranslucentSysUI()}
@@ -156,10 +159,13 @@ static void suspendEmulation(EmuApp &app)
 		return;
 	app.autosaveManager.save();
 	app.system().flushBackupMemory(app);
+	// the app may be killed once backgrounded, so don't leave the state write pending
+	app.autosaveManager.waitForPendingSave();
 }
 
 void EmuApp::closeSystem()
 {
+	setAVCapture(false);
 	systemTask.stop();
 	showUI();
 	system().closeRuntimeSystem(*this);
@@ -209,14 +215,36 @@ void EmuApp::showExitAlert(ViewAttachParams attach, const Input::Event &e)
 		attach, system().hasContent()), e, false);
 }
 
-static const char *parseCommandArgs(IG::CommandArgs arg)
+const char *EmuApp::parseCommandArgs(IG::CommandArgs arg)
 {
-	if(arg.c < 2)
+	const char *launchPath{};
+	for(auto argStr : std::span{arg.v, size_t(arg.c)}.subspan(std::min(arg.c, 1)))
+	{
+		std::string_view argView{argStr};
+		if(argView == "--benchmark")
+		{
+			commandBenchmark.frames = 1800;
+		}
+		else if(argView.starts_with("--benchmark="))
+		{
+			commandBenchmark.frames = std::max(std::atoi(argStr + argView.find('=') + 1), 1);
+		}
+		else if(argView == "--benchmark-no-video")
+		{
+			commandBenchmark.withoutVideo = true;
+		}
+		else if(!launchPath)
+		{
+			launchPath = argStr;
+		}
+	}
+	if(!launchPath)
 	{
 		return nullptr;
 	}
-	auto launchPath = arg.v[1];
 	log.info("starting content from command line:{}", launchPath);
+	if(commandBenchmark.frames)
+		log.info("benchmarking {} frames{}", commandBenchmark.frames, commandBenchmark.withoutVideo ? " without video" : "");
 	return launchPath;
 }
 
@@ -539,7 +567,10 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 				launchPathStr.size())
 			{
 				system().setInitialLoadPath("");
-				handleOpenFileCommand(launchPathStr);
+				if(commandBenchmark.frames)
+					runBenchmarkFromCommand(launchPathStr);
+				else
+					handleOpenFileCommand(launchPathStr);
 			}
 
 			win.show();
@@ -644,15 +675,53 @@ void EmuApp::handleOpenFileCommand(CStringView path)
 	}
 }
 
+static std::string benchmarkResultString(const BenchmarkResult &res)
+{
+	using FloatMilliseconds = std::chrono::duration<double, std::milli>;
+	auto ms = [](SteadyClockDuration d) { return duration_cast<FloatMilliseconds>(d).count(); };
+	return std::format("{} frames in {:.3f}s, {:.2f} fps, frame time median:{:.3f}ms p95:{:.3f}ms p99:{:.3f}ms max:{:.3f}ms",
+		res.frames, duration_cast<FloatSeconds>(res.duration).count(), res.framesPerSecond(),
+		ms(res.medianFrameTime), ms(res.p95FrameTime), ms(res.p99FrameTime), ms(res.maxFrameTime));
+}
+
 void EmuApp::runBenchmarkOneShot(EmuVideo &video)
 {
 	log.info("starting benchmark");
-	auto time = system().benchmark(video);
+	auto res = system().benchmark(&video);
 	autosaveManager.resetSlot(noAutosaveName);
 	closeSystem();
-	auto timeSecs = duration_cast<FloatSeconds>(time);
-	log.info("done in:{}", timeSecs);
-	postMessage(2, 0, std::format("{:.2f} fps", 180. / timeSecs.count()));
+	log.info("done, {}", benchmarkResultString(res));
+	postMessage(2, 0, std::format("{:.2f} fps", res.framesPerSecond()));
+}
+
+void EmuApp::runBenchmarkFromCommand(CStringView path)
+{
+	auto name = appContext().fileUriDisplayName(path);
+	if(name.empty())
+	{
+		log.error("can't access path name for:{}", path);
+		appContext().exit(1);
+		return;
+	}
+	bool started = createSystemWithMedia({}, path, name, Input::KeyEvent{}, {}, attachParams(),
+		[this](const Input::Event &)
+		{
+			log.info("starting benchmark from command line");
+			auto res = system().benchmark(commandBenchmark.withoutVideo ? nullptr : &video, commandBenchmark.frames);
+			autosaveManager.resetSlot(noAutosaveName);
+			closeSystem();
+			auto resStr = benchmarkResultString(res);
+			log.info("done, {}", resStr);
+			// print results on their own line so scripts can parse them
+			std::fputs(std::format("{}: {}\n", system().shortSystemName(), resStr).c_str(), stdout);
+			std::fflush(stdout);
+			appContext().exit();
+		});
+	if(!started)
+	{
+		log.error("can't load content:{}", path);
+		appContext().exit(1);
+	}
 }
 
 void EmuApp::showEmulation()
@@ -784,7 +853,7 @@ void EmuApp::printScreenshotResult(bool success)
 		appContext().formatDateAndTime(WallClock::now())));
 }
 
-void EmuApp::createSystemWithMedia(IO io, CStringView path, std::string_view displayName,
+bool EmuApp::createSystemWithMedia(IO io, CStringView path, std::string_view displayName,
 	const Input::Event &e, EmuSystemCreateParams params, ViewAttachParams attachParams,
 	CreateSystemCompleteDelegate onComplete)
 {
@@ -792,36 +861,50 @@ void EmuApp::createSystemWithMedia(IO io, CStringView path, std::string_view dis
 	if(!EmuApp::hasArchiveExtension(displayName) && !EmuSystem::defaultFsFilter(displayName))
 	{
 		postErrorMessage("File doesn't have a valid extension");
-		return;
+		return false;
 	}
 	if(!EmuApp::willCreateSystem(attachParams, e))
 	{
-		return;
+		return false;
 	}
 	closeSystem();
 	auto loadProgressView = std::make_unique<LoadProgressView>(attachParams, e, onComplete);
-	auto &msgPort = loadProgressView->messagePort();
+	auto &progressView = *loadProgressView;
 	pushAndShowModalView(std::move(loadProgressView), e);
 	IG::makeDetachedThread(
-		[this, io{std::move(io)}, pathStr = FS::PathString{path}, nameStr = FS::FileString{displayName}, &msgPort, params]() mutable
+		[this, io{std::move(io)}, pathStr = FS::PathString{path}, nameStr = FS::FileString{displayName}, &progressView, params]() mutable
 		{
 			log.info("starting loader thread");
+			// the view stays on screen until it receives a terminal message so it's safe to reference here
+			auto &msgPort = progressView.messagePort();
 			try
 			{
 				system().createWithMedia(std::move(io), pathStr, nameStr, params,
-					[&msgPort](int pos, int max, const char *label)
+					[&progressView](int pos, int max, const char *label)
 					{
 						int len = label ? std::string_view{label}.size() : -1;
 						auto msg = EmuSystem::LoadProgressMessage{EmuSystem::LoadProgress::UPDATE, pos, max, len};
-						msgPort.sendWithExtraData(msg, std::span{label, len > 0 ? size_t(len) : 0});
-						return true;
+						progressView.messagePort().sendWithExtraData(msg, std::span{label, len > 0 ? size_t(len) : 0});
+						return !progressView.isCanceled();
 					});
+				if(progressView.isCanceled())
+				{
+					log.info("loader thread canceled after loading");
+					msgPort.send({EmuSystem::LoadProgress::CANCELED, 0, 0, 0});
+					return;
+				}
 				msgPort.send({EmuSystem::LoadProgress::OK, 0, 0, 0});
 				log.info("loader thread finished");
 			}
 			catch(std::exception &err)
 			{
 				system().clearGamePaths();
+				if(progressView.isCanceled())
+				{
+					log.info("loader thread canceled:{}", err.what());
+					msgPort.send({EmuSystem::LoadProgress::CANCELED, 0, 0, 0});
+					return;
+				}
 				std::string_view errStr{err.what()};
 				auto len = errStr.size();
 				if(len > 1024)
@@ -834,6 +917,7 @@ void EmuApp::createSystemWithMedia(IO io, CStringView path, std::string_view dis
 				return;
 			}
 		});
+	return true;
 }
 
 FS::PathString EmuApp::contentSavePath(std::string_view name) const
@@ -879,8 +963,13 @@ size_t EmuApp::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 
 DynArray<uint8_t> EmuApp::saveState()
 {
-	auto suspendCtx = suspendEmulationThread();
-	return system().saveState();
+	// only capture the state with emulation paused, compression runs after it resumes
+	auto state = [&]
+	{
+		auto suspendCtx = suspendEmulationThread();
+		return system().captureState();
+	}();
+	return EmuSystem::packState(std::move(state));
 }
 
 bool EmuApp::saveState(CStringView path, bool notify)
@@ -891,12 +980,15 @@ bool EmuApp::saveState(CStringView path, bool notify)
 		return false;
 	}
 	log.info("saving state {}", path);
-	auto suspendCtx = suspendEmulationThread();
 	try
 	{
-		system().saveState(path);
-		if(notify)
-			postMessage("State Saved");
+		auto state = [&]
+		{
+			auto suspendCtx = suspendEmulationThread();
+			return system().captureState();
+		}();
+		// compressing and writing the file finish on the autosave I/O thread, which reports the result
+		autosaveManager.queueStateFileWrite(FS::PathString{path}, std::move(state), notify);
 		return true;
 	}
 	catch(std::exception &err)
@@ -919,6 +1011,7 @@ bool EmuApp::loadState(CStringView path)
 		return false;
 	}
 	log.info("loading state {}", path);
+	autosaveManager.waitForPendingSave(); // the state may still be queued for writing
 	auto suspendCtx = suspendEmulationThread();
 	try
 	{
@@ -1291,6 +1384,12 @@ void EmuApp::configureSecondaryScreens()
 
 void EmuApp::record(FrameTimingStatEvent event, SteadyClockTimePoint t)
 {
+	if(frameTrace.isEnabled()) [[unlikely]]
+	{
+		frameTrace.record(event, t);
+		if(event == FrameTimingStatEvent::endOfFrame)
+			frameTrace.commitFrame(audio.framesWritten(), audio.takeUnderruns());
+	}
 	if(!viewController().emuView.showingFrameTimingStats())
 			return;
 	auto setTime = [](auto& var, SteadyClockTimePoint t)
@@ -1309,6 +1408,75 @@ void EmuApp::record(FrameTimingStatEvent event, SteadyClockTimePoint t)
 	std::unreachable();
 }
 
+bool EmuApp::exportFrameTrace()
+{
+	if(!frameTrace.size())
+	{
+		postErrorMessage("No frames recorded");
+		return false;
+	}
+	auto &sys = system();
+	auto suspendCtx = suspendEmulationThread();
+	try
+	{
+		static constexpr std::string_view subDirName = "traces";
+		auto userPath = sys.userPath(userScreenshotPath);
+		sys.createContentLocalDirectory(userPath, subDirName);
+		auto baseName = appContext().formatDateAndTimeAsFilename(WallClock::now());
+		auto csvPath = sys.contentLocalDirectory(userPath, subDirName, baseName + ".csv");
+		auto jsonPath = sys.contentLocalDirectory(userPath, subDirName, baseName + ".json");
+		auto csv = frameTrace.toCSV();
+		appContext().openFileUri(csvPath, OpenFlags::newFile()).write(std::span{csv});
+		auto json = frameTrace.toChromeTrace();
+		appContext().openFileUri(jsonPath, OpenFlags::newFile()).write(std::span{json});
+		log.info("wrote {} frame trace entries to {}", frameTrace.size(), jsonPath);
+		postMessage(4, false, std::format("Wrote {} frames to:\n{}", frameTrace.size(), jsonPath));
+		return true;
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(4, std::format("Can't export frame trace:\n{}", err.what()));
+		return false;
+	}
+}
+
+void EmuApp::setAVCapture(bool on)
+{
+	if(on == avCapture.isActive())
+		return;
+	auto suspendCtx = suspendEmulationThread();
+	if(!on)
+	{
+		audio.avCapture = nullptr;
+		auto stats = avCapture.stop();
+		postMessage(3, false, std::format("Capture stopped, {} frames, {} dropped", stats.frames, stats.droppedFrames));
+		return;
+	}
+	auto &sys = system();
+	if(!sys.hasContent())
+	{
+		postErrorMessage("System not running");
+		return;
+	}
+	try
+	{
+		static constexpr std::string_view subDirName = "captures";
+		auto userPath = sys.userPath(userScreenshotPath);
+		sys.createContentLocalDirectory(userPath, subDirName);
+		auto baseName = appContext().formatDateAndTimeAsFilename(WallClock::now());
+		auto videoPath = sys.contentLocalDirectory(userPath, subDirName, baseName + ".exav");
+		auto audioPath = sys.contentLocalDirectory(userPath, subDirName, baseName + ".wav");
+		avCapture.start(appContext().openFileUri(videoPath, OpenFlags::newFile()),
+			appContext().openFileUri(audioPath, OpenFlags::newFile()), sys.frameRate().duration(), audio.format());
+		audio.avCapture = &avCapture;
+		postMessage(3, false, std::format("Capturing to:\n{}", videoPath));
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(4, std::format("Can't start capture:\n{}", err.what()));
+	}
+}
+
 bool EmuApp::setAltSpeed(AltSpeedMode mode, int16_t speed)
 {
 	if(mode == AltSpeedMode::slow)
@@ -15,6 +15,7 @@
 
 #include <emuframework/EmuOptions.hh>
 #include <emuframework/EmuAudio.hh>
+#include <emuframework/AVCapture.hh>
 #include <emuframework/EmuSystem.hh>
 #include <emuframework/Option.hh>
 #include <imagine/audio/Manager.hh>
@@ -81,46 +82,6 @@ bool EmuAudio::shouldStartAudioWrites(size_t bytesToWrite) const
 	return rBuff.size() + bytesToWrite >= targetBufferFillBytes;
 }
 
-template<typename T>
-static void simpleResample(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames)
-{
-	if(!destFrames)
-		return;
-	float ratio = (float)srcFrames/(float)destFrames;
-	for(auto i : iotaCount(destFrames))
-	{
-		size_t srcPos = std::floor((float)i * ratio);
-		if(srcPos >= srcFrames) [[unlikely]]
-		{
-			log.info("resample pos {} too high", srcPos);
-			srcPos = srcFrames-1;
-		}
-		dest[i] = src[srcPos];
-	}
-}
-
-static void simpleResample(void *dest, size_t destFrames, const void *src, size_t srcFrames, IG::Audio::Format format)
-{
-	if(format.channels == 1)
-	{
-		if(format.sample.isFloat())
-			simpleResample((uint32_t*)dest, destFrames, (uint32_t*)src, srcFrames);
-		else
-			simpleResample((uint16_t*)dest, destFrames, (uint16_t*)src, srcFrames);
-	}
-	else
-	{
-		if(format.channels != 2)
-		{
-			bug_unreachable("channels == %d", format.channels);
-		}
-		if(format.sample.isFloat())
-			simpleResample((uint64_t*)dest, destFrames, (uint64_t*)src, srcFrames);
-		else
-			simpleResample((uint32_t*)dest, destFrames, (uint32_t*)src, srcFrames);
-	}
-}
-
 void EmuAudio::resizeAudioBuffer(size_t targetBufferFillBytes)
 {
 	auto oldCapacity = rBuff.capacity();
@@ -190,6 +151,7 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 							audioWriteState = AudioWriteState::UNDERRUN;
 						}
 						lastUnderrunTime = now;
+						underruns.fetch_add(1, std::memory_order_relaxed);
 						#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 						audioStats.underruns++;
 						#endif
@@ -249,12 +211,27 @@ void EmuAudio::flush()
 	if(audioStream)
 		audioStream.flush();
 	rBuff.clear();
+	resamplerHasHistory = false;
+}
+
+// Returns the resampler, resetting it if the previous write was copied
+// since its history and position no longer follow the written audio
+AudioResampler &EmuAudio::continuedResampler()
+{
+	if(!resamplerHasHistory)
+	{
+		resampler.reset();
+		resamplerHasHistory = true;
+	}
+	return resampler;
 }
 
 void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 {
 	if(!framesToWrite) [[unlikely]]
 		return;
+	if(avCapture) [[unlikely]]
+		avCapture->addAudio(samples, framesToWrite);
 	assumeExpr(rBuff.capacity());
 	auto inputFormat = format();
 	switch(audioWriteState)
@@ -275,23 +252,27 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		break;
 	}
 	const size_t sampleFrames = framesToWrite;
-	if(speedMultiplier != 1.) [[unlikely]]
+	const double ratio = speedMultiplier * rateControlRatio();
+	if(ratio != 1.)
 	{
-		framesToWrite = std::ceil((double)framesToWrite / speedMultiplier);
-		framesToWrite = std::max(framesToWrite, 1zu);
+		framesToWrite = AudioResampler::maxOutputFrames(framesToWrite, ratio);
 	}
 	auto bytes = inputFormat.framesToBytes(framesToWrite);
 	{
 		auto span = rBuff.beginWrite(bytes);
 		if(bytes <= span.size())
 		{
-			if(sampleFrames != framesToWrite)
+			// the output frame count can round back to the input count for ratios close to 1,
+			// so only skip resampling when no rate correction is needed
+			if(ratio != 1.)
 			{
-				simpleResample(span.data(), framesToWrite, samples, sampleFrames, inputFormat);
+				bytes = inputFormat.framesToBytes(
+					continuedResampler().resample(span.data(), framesToWrite, samples, sampleFrames, ratio, inputFormat));
 			}
 			else
 			{
 				copy_n(static_cast<const uint8_t*>(samples), bytes, span.data());
+				resamplerHasHistory = false;
 			}
 		}
 		else // not enough space for write
@@ -301,9 +282,10 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 			audioStats.overruns++;
 			#endif
 			auto freeFrames = inputFormat.bytesToFrames(span.size());
-			simpleResample(span.data(), freeFrames, samples, sampleFrames, inputFormat);
+			bytes = freeFrames ? inputFormat.framesToBytes(
+				continuedResampler().resample(span.data(), freeFrames, samples, sampleFrames, (double)sampleFrames / freeFrames, inputFormat)) : 0;
 		}
-		rBuff.endWrite(span);
+		rBuff.endWrite({span.first(bytes), span.idxs});
 	}
 	if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites(bytes))
 	{
@@ -347,6 +329,7 @@ void EmuAudio::setSpeedMultiplier(double speed)
 	if(speedMultiplier == speed)
 		return;
 	speedMultiplier = speed;
+	resampler.reset();
 	log.info("set speed multiplier:{}", speed);
 	updateVolume();
 	updateAddBuffersOnUnderrun();
@@ -369,6 +352,23 @@ void EmuAudio::updateVolume()
 	}
 }
 
+double EmuAudio::rateControlRatio()
+{
+	static constexpr double maxRateAdjust = .005;
+	static constexpr double fillSmoothing = .05;
+	if(!dynamicRateControl || audioWriteState != AudioWriteState::ACTIVE || !targetBufferFillBytes)
+	{
+		avgBufferFillBytes = 0;
+		return 1.;
+	}
+	// smooth the fill level since it jumps with every write and device callback,
+	// then consume input slightly faster or slower to pull it towards the target
+	double fillBytes = rBuff.size();
+	avgBufferFillBytes = avgBufferFillBytes ? avgBufferFillBytes + (fillBytes - avgBufferFillBytes) * fillSmoothing : fillBytes;
+	auto error = std::clamp((avgBufferFillBytes - targetBufferFillBytes) / targetBufferFillBytes, -1., 1.);
+	return 1. + error * maxRateAdjust;
+}
+
 void EmuAudio::updateAddBuffersOnUnderrun() { addSoundBuffersOnUnderrun = speedMultiplier == 1. ? addSoundBuffersOnUnderrunSetting : false; }
 
 constexpr bool isValidVolumeSetting(int8_t vol) { return vol >= 0 && vol <= 125; }
@@ -439,6 +439,7 @@ void EmuAudio::writeConfig(FileIO &io) const
 	writeOptionValueIfNotDefault(io, soundBuffers);
 	writeOptionValueIfNotDefault(io, CFGKEY_SOUND_VOLUME, maxVolume(), 100);
 	writeOptionValueIfNotDefault(io, CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN, addSoundBuffersOnUnderrunSetting, false);
+	writeOptionValueIfNotDefault(io, CFGKEY_DYNAMIC_RATE_CONTROL, dynamicRateControl, true);
 	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_API, audioAPI, Audio::Api::DEFAULT);
 }
 
@@ -451,6 +452,7 @@ bool EmuAudio::readConfig(MapIO &io, unsigned key)
 		case CFGKEY_SOUND_BUFFERS: return readOptionValue(io, soundBuffers);
 		case CFGKEY_SOUND_VOLUME: return readOptionValue<int8_t>(io, [&](auto v){ setMaxVolume(v); }, isValidVolumeSetting);
 		case CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN: return readOptionValue(io, addSoundBuffersOnUnderrunSetting);
+		case CFGKEY_DYNAMIC_RATE_CONTROL: return readOptionValue(io, dynamicRateControl);
 		case CFGKEY_AUDIO_API: return readOptionValue(io, audioAPI);
 	}
 	return false;
@@ -140,6 +140,20 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 			app.video.takeGameScreenshot();
 			return true;
 		}
+		case takeBurstScreenshot:
+		{
+			if(!isPushed)
+				break;
+			app.video.takeGameScreenshot(ScreenshotWriter::burstFrames);
+			return true;
+		}
+		case toggleAVCapture:
+		{
+			if(!isPushed)
+				break;
+			app.setAVCapture(!app.avCapture.isActive());
+			return true;
+		}
 		case toggleFastForward:
 		{
 			if(!isPushed)
@@ -184,6 +198,12 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 		break;
 		case rewind:
 		{
+			if(app.rewindManager.frameInterval)
+			{
+				// rewinding continues on the emulation thread while the key is held
+				app.rewindManager.isRewinding = isPushed && app.rewindManager.maxStates;
+				break;
+			}
 			if(!isPushed)
 				break;
 			app.rewindManager.rewindState(app);
@@ -659,6 +679,8 @@ std::string_view toString(AppKeyCode code)
 		case AppKeyCode::incStateSlot: return "Increment State Slot";
 		case AppKeyCode::fastForward: return "Fast-forward";
 		case AppKeyCode::takeScreenshot: return "Take Screenshot";
+		case AppKeyCode::takeBurstScreenshot: return "Take Burst Screenshots";
+		case AppKeyCode::toggleAVCapture: return "Toggle A/V Capture";
 		case AppKeyCode::openMenu: return "Open Menu";
 		case AppKeyCode::toggleFastForward: return "Toggle Fast-forward";
 		case AppKeyCode::turboModifier: return "Turbo Modifier";
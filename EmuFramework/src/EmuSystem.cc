@@ -19,6 +19,7 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuViewController.hh>
+#include <emuframework/StateCodec.hh>
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/fs/FSUtils.hh>
@@ -33,6 +34,7 @@
 #include <imagine/logger/logger.h>
 #include <algorithm>
 #include <cstring>
+#include <vector>
 #include "pathUtils.hh"
 
 namespace EmuEx
@@ -55,6 +57,7 @@ constexpr SystemLogger log{"EmuSystem"};
 [[gnu::weak]] F2Size EmuSystem::validFrameRateRange{minFrameRate, 80.};
 [[gnu::weak]] bool EmuSystem::hasRectangularPixels = false;
 [[gnu::weak]] bool EmuSystem::stateSizeChangesAtRuntime = false;
+[[gnu::weak]] bool EmuSystem::skipsUnchangedVideoRows = false;
 
 bool EmuSystem::stateExists(int slot) const
 {
@@ -75,8 +78,17 @@ bool EmuApp::shouldOverwriteExistingState() const
 
 void EmuSystem::loadState(EmuApp &app, CStringView uri)
 {
-	auto file = appContext().openFileUri(uri, {.accessHint = IOAccessHint::All});
-	readState(app, file.buffer(IOBufferMode::Release));
+	// map the file without pre-faulting all pages so the core can start parsing
+	// the state while the kernel reads ahead
+	auto file = appContext().openFileUri(uri, {.accessHint = IOAccessHint::Sequential});
+	auto buff = file.buffer(IOBufferMode::Release);
+	if(hasStateCodecHeader(buff.span()))
+	{
+		auto uncompArr = uncompressState(buff.span());
+		readState(app, uncompArr);
+		return;
+	}
+	readState(app, buff);
 }
 
 void EmuSystem::saveState(CStringView uri)
@@ -87,9 +99,23 @@ void EmuSystem::saveState(CStringView uri)
 
 DynArray<uint8_t> EmuSystem::saveState()
 {
-	auto stateArr = dynArrayForOverwrite<uint8_t>(stateSize());
-	stateArr.trim(writeState(stateArr));
-	return stateArr;
+	return packState(captureState());
+}
+
+CapturedState EmuSystem::captureState()
+{
+	auto size = stateSize();
+	bool needsCompression = size >= stateCodecMinSize;
+	auto stateArr = dynArrayForOverwrite<uint8_t>(size);
+	stateArr.trim(writeState(stateArr, {.uncompressed = needsCompression}));
+	return {std::move(stateArr), needsCompression};
+}
+
+DynArray<uint8_t> EmuSystem::packState(CapturedState state)
+{
+	if(!state.needsCompression)
+		return std::move(state.data);
+	return compressState(state.data.span());
 }
 
 DynArray<uint8_t> EmuSystem::uncompressGzipState(std::span<uint8_t> buff, size_t expectedSize)
@@ -298,6 +324,7 @@ void EmuSystem::pause(EmuApp &app)
 	app.audio.stop();
 	app.autosaveManager.pauseTimer();
 	app.rewindManager.pauseTimer();
+	app.rewindManager.isRewinding = false;
 	onStop();
 }
 
@@ -320,14 +347,30 @@ void EmuSystem::start(EmuApp &app)
 	app.rewindManager.startTimer();
 }
 
-SteadyClockDuration EmuSystem::benchmark(EmuVideo& video)
+BenchmarkResult EmuSystem::benchmark(EmuVideo* video, int frames)
 {
+	assumeExpr(frames > 0);
+	std::vector<SteadyClockDuration> frameTimes(frames);
 	auto before = SteadyClock::now();
-	for(auto _ : iotaCount(180))
+	auto frameStart = before;
+	for(auto &t : frameTimes)
 	{
-		runFrame({}, &video, nullptr);
+		runFrame({}, video, nullptr);
+		auto now = SteadyClock::now();
+		t = now - frameStart;
+		frameStart = now;
 	}
-	return SteadyClock::now() - before;
+	std::ranges::sort(frameTimes);
+	auto percentile = [&](int p) { return frameTimes[(frames - 1) * p / 100]; };
+	return
+	{
+		.frames = frames,
+		.duration = frameStart - before,
+		.medianFrameTime = percentile(50),
+		.p95FrameTime = percentile(95),
+		.p99FrameTime = percentile(99),
+		.maxFrameTime = frameTimes.back(),
+	};
 }
 
 void EmuSystem::configFrameRate(int outputRate, FrameDuration outputFrameDuration)
@@ -416,30 +459,56 @@ void EmuSystem::loadContentFromPath(CStringView pathStr, std::string_view displa
 		return;
 	}
 	log.info("load from {}:{}", IG::isUri(path) ? "uri" : "path", path);
+	// only content opened by path can be re-opened if extracting to the archive cache fails
 	loadContentFromFile(appContext().openFileUri(path, {.accessHint = IOAccessHint::Sequential}),
-		path, displayName, params, onLoadProgress);
+		path, displayName, params, onLoadProgress, true);
 }
 
-void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
+void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress,
+	bool canCacheArchiveEntry)
 {
 	if(!EmuSystem::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
 	{
 		IO io{};
 		FS::FileString originalName{};
-		for(auto &entry : FS::ArchiveIterator{std::move(file)})
+		auto &archiveCache = EmuApp::get(appContext()).archiveCache;
+		auto archiveSize = file.size();
+		auto findEntry = [&](IO archive, bool useCache)
 		{
-			if(entry.type() == FS::file_type::directory)
-			{
-				continue;
-			}
-			auto name = entry.name();
-			log.info("archive file entry:{}", name);
-			if(EmuSystem::defaultFsFilter(name))
+			for(auto &entry : FS::ArchiveIterator{std::move(archive)})
 			{
-				originalName = name;
-				io = std::move(entry);
-				break;
+				if(entry.type() == FS::file_type::directory)
+				{
+					continue;
+				}
+				auto name = entry.name();
+				log.info("archive file entry:{}", name);
+				if(EmuSystem::defaultFsFilter(name))
+				{
+					originalName = name;
+					if(useCache)
+					{
+						if(auto cachedIO = archiveCache.openEntry(path, archiveSize, entry))
+						{
+							io = std::move(cachedIO);
+							return;
+						}
+					}
+					io = std::move(entry);
+					return;
+				}
 			}
+		};
+		try
+		{
+			findEntry(std::move(file), canCacheArchiveEntry);
+		}
+		catch(std::exception &err)
+		{
+			// entry was partly consumed, re-open the archive and stream it directly
+			log.warn("archive cache error:{}", err.what());
+			io = {};
+			findEntry(appContext().openFileUri(path, {.accessHint = IOAccessHint::Sequential}), false);
 		}
 		if(!io)
 		{
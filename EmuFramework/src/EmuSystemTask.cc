@@ -48,6 +48,7 @@ void EmuSystemTask::start(Window& win)
 	win.removeFrameEvents();
 	win.setDrawEventEnabled(false); // block UI from posting draws
 	shouldWaitForPresent = app.lowLatencyVideo && app.effectiveFrameClockSource() != FrameClockSource::Renderer;
+	runAheadState = {}; // state size may have changed since the last run, allocated on first use
 	setWindowInternal(win);
 	taskThread = makeThreadSync(
 		[this](auto &sem)
@@ -443,8 +444,21 @@ bool EmuSystemTask::advanceFrames(FrameParams frameParams)
 		app.record(FrameTimingStatEvent::startOfEmulation);
 		shouldWait = setWaitForPresent();
 	}
+	bool isRewinding = app.rewindManager.isRewinding;
+	if(isRewinding) [[unlikely]]
+	{
+		// step back one saved state and run a single frame to display it
+		app.rewindManager.stepBack(app);
+		frameInfo.advanced = 1;
+		audioPtr = nullptr;
+	}
 	//log.debug("running {} frame(s), skip:{}", frameInfo.advanced, !videoPtr);
-	sys.runFrames({this}, videoPtr, audioPtr, frameInfo.advanced);
+	if(app.runAheadFrames && videoPtr && !isRewinding)
+		runFramesAhead(*videoPtr, audioPtr, frameInfo.advanced, app.runAheadFrames);
+	else
+		sys.runFrames({this}, videoPtr, audioPtr, frameInfo.advanced);
+	if(!isRewinding)
+		app.rewindManager.onFramesAdvanced(sys, frameInfo.advanced);
 	app.inputManager.turboActions.update(app);
 	if(!videoPtr)
 		return false;
@@ -461,6 +475,47 @@ bool EmuSystemTask::advanceFrames(FrameParams frameParams)
 	return true;
 }
 
+void EmuSystemTask::runFramesAhead(EmuVideo& video, EmuAudio* audio, int frames, int aheadFrames)
+{
+	auto &sys = app.system();
+	if(!runAheadState.size() || EmuSystem::stateSizeChangesAtRuntime)
+	{
+		// re-check cores with a variable state size every call, the buffer only grows
+		auto stateSize = sys.stateSize();
+		if(stateSize > runAheadState.size())
+		{
+			try
+			{
+				runAheadState = dynArrayForOverwrite<uint8_t>(stateSize);
+				log.info("allocated {} byte run-ahead state", runAheadState.size());
+			}
+			catch(...)
+			{
+				log.error("not enough memory for run-ahead state");
+				runAheadState = {};
+				// the option is owned by the main thread, run frames normally until it's turned off
+				app.runOnMainThread([&app = app](ApplicationContext)
+				{
+					if(!app.runAheadFrames)
+						return;
+					app.runAheadFrames.setUnchecked(0);
+					app.postErrorMessage("Not enough memory for run-ahead, disabling it");
+				});
+				sys.runFrames({this}, &video, audio, frames);
+				return;
+			}
+		}
+	}
+	// emulate the real frames without video and save the resulting state, then
+	// run ahead with no audio so the displayed frame reflects input sooner
+	sys.skipFrames({this}, frames, audio);
+	auto stateSize = sys.writeState(runAheadState, {.uncompressed = true});
+	sys.skipFrames({this}, aheadFrames - 1, nullptr);
+	sys.runFrame({this}, &video, nullptr);
+	sys.readState(app, {runAheadState.data(), stateSize});
+	sys.updateBackupMemoryCounter();
+}
+
 void EmuSystemTask::notifyWindowPresented()
 {
 	if(waitingForPresent_)
@@ -15,6 +15,7 @@
 
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuApp.hh>
+#include <emuframework/IndexedPalette.hh>
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gfx/RendererCommands.hh>
@@ -127,6 +128,14 @@ void EmuVideo::startFrameWithAltFormat(EmuSystemTaskContext taskCtx, IG::PixmapV
 	}
 }
 
+void EmuVideo::startIndexedFrame(EmuSystemTaskContext taskCtx, IG::PixmapView indexedPix, IndexedPalette &palette)
+{
+	auto img = startFrame(taskCtx);
+	assumeExpr(img.pixmap().size() == indexedPix.size());
+	palette.write(img.pixmap(), indexedPix);
+	img.endFrame();
+}
+
 void EmuVideo::startUnchangedFrame(EmuSystemTaskContext taskCtx)
 {
 	postFrameFinished(taskCtx);
@@ -142,21 +151,29 @@ void EmuVideo::postFrameFinished(EmuSystemTaskContext taskCtx)
 
 void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffer texBuff)
 {
-	if(screenshotNextFrame) [[unlikely]]
+	if(app().screenshotWriter.isPending()) [[unlikely]]
+	{
+		app().screenshotWriter.capture(texBuff.pixmap());
+	}
+	if(app().avCapture.isActive()) [[unlikely]]
 	{
-		doScreenshot(taskCtx, texBuff.pixmap());
+		app().avCapture.addFrame(texBuff.pixmap());
 	}
-	vidImg.unlock(texBuff);
+	app().frameTrace.traceVideoUpload([&]{ vidImg.unlock(texBuff, {.skipUnchangedRows = EmuSystem::skipsUnchangedVideoRows}); });
 	postFrameFinished(taskCtx);
 }
 
 void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 {
-	if(screenshotNextFrame) [[unlikely]]
+	if(app().screenshotWriter.isPending()) [[unlikely]]
+	{
+		app().screenshotWriter.capture(pix);
+	}
+	if(app().avCapture.isActive()) [[unlikely]]
 	{
-		doScreenshot(taskCtx, pix);
+		app().avCapture.addFrame(pix);
 	}
-	vidImg.write(pix, {.async = true});
+	app().frameTrace.traceVideoUpload([&]{ vidImg.write(pix, {.async = true}); });
 	postFrameFinished(taskCtx);
 }
 
@@ -167,23 +184,9 @@ void EmuVideo::clear()
 	vidImg.clear();
 }
 
-void EmuVideo::takeGameScreenshot()
-{
-	screenshotNextFrame = true;
-}
-
-void EmuVideo::doScreenshot(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
+void EmuVideo::takeGameScreenshot(int frames)
 {
-	screenshotNextFrame = false;
-	auto success = app().writeScreenshot(pix, app().makeNextScreenshotFilename());
-	if(taskCtx)
-	{
-		taskCtx.task().sendScreenshotReply(success);
-	}
-	else
-	{
-		app().printScreenshotResult(success);
-	}
+	app().screenshotWriter.request(frames);
 }
 
 bool EmuVideo::isExternalTexture() const
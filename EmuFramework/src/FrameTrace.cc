@@ -0,0 +1,167 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/FrameTrace.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"FrameTrace"};
+
+void FrameTrace::setEnabled(bool on, size_t capacity)
+{
+	committed.store(0, std::memory_order_relaxed);
+	pending = {};
+	if(on)
+	{
+		entries = dynArrayForOverwrite<FrameTraceEntry>(capacity);
+		log.info("recording up to {} frames", capacity);
+	}
+	else
+	{
+		entries = {};
+	}
+}
+
+void FrameTrace::record(FrameTimingStatEvent event, SteadyClockTimePoint t)
+{
+	if(!hasTime(t))
+		t = SteadyClock::now();
+	switch(event)
+	{
+		case FrameTimingStatEvent::startOfFrame: pending = {.startOfFrame = t}; return;
+		case FrameTimingStatEvent::startOfEmulation: pending.startOfEmulation = t; return;
+		case FrameTimingStatEvent::waitForPresent: pending.waitForPresent = t; return;
+		case FrameTimingStatEvent::endOfFrame: pending.endOfFrame = t; return;
+	}
+}
+
+void FrameTrace::recordVideoUpload(SteadyClockTimePoint start, SteadyClockTimePoint end)
+{
+	pending.startOfVideoUpload = start;
+	pending.videoUpload = end - start;
+}
+
+void FrameTrace::commitFrame(uint32_t audioFramesBuffered, uint32_t audioUnderruns)
+{
+	if(!hasTime(pending.startOfFrame))
+		return;
+	pending.audioFramesBuffered = audioFramesBuffered;
+	pending.audioUnderruns = audioUnderruns;
+	auto count = committed.load(std::memory_order_relaxed);
+	entries[count % entries.size()] = pending;
+	committed.store(count + 1, std::memory_order_release);
+	pending = {};
+}
+
+size_t FrameTrace::size() const
+{
+	return std::min(committed.load(std::memory_order_acquire), entries.size());
+}
+
+void FrameTrace::forEachEntry(auto &&func) const
+{
+	auto count = committed.load(std::memory_order_acquire);
+	auto size = std::min(count, entries.size());
+	for(auto i : iotaCount(size))
+	{
+		func(entries[(count - size + i) % entries.size()]);
+	}
+}
+
+static double toMicros(SteadyClockDuration d) { return std::chrono::duration<double, std::micro>{d}.count(); }
+
+static double toMicros(SteadyClockTimePoint t, SteadyClockTimePoint base)
+{
+	return hasTime(t) ? toMicros(t - base) : 0.;
+}
+
+std::string FrameTrace::toCSV() const
+{
+	std::string str{"frame,start_us,emulate_us,video_upload_us,present_us,total_us,audio_frames_buffered,audio_underruns\n"};
+	size_t frame{};
+	SteadyClockTimePoint base{};
+	forEachEntry([&](const FrameTraceEntry &e)
+	{
+		if(!frame)
+			base = e.startOfFrame;
+		auto emulateEnd = hasTime(e.waitForPresent) ? e.waitForPresent : e.endOfFrame;
+		std::format_to(std::back_inserter(str), "{},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},{},{}\n",
+			frame++, toMicros(e.startOfFrame, base),
+			hasTime(e.startOfEmulation) ? toMicros(emulateEnd - e.startOfEmulation) : 0.,
+			toMicros(e.videoUpload),
+			hasTime(e.waitForPresent) ? toMicros(e.endOfFrame - e.waitForPresent) : 0.,
+			toMicros(e.endOfFrame - e.startOfFrame),
+			e.audioFramesBuffered, e.audioUnderruns);
+	});
+	return str;
+}
+
+std::string FrameTrace::toChromeTrace() const
+{
+	std::string str{"{\"traceEvents\":[\n"};
+	bool firstEvent = true;
+	auto addEvent = [&](std::string_view name, char phase, double ts, double dur = -1.)
+	{
+		std::format_to(std::back_inserter(str), "{}{{\"name\":\"{}\",\"ph\":\"{}\",\"pid\":1,\"tid\":1,\"ts\":{:.1f}",
+			firstEvent ? "" : ",\n", name, phase, ts);
+		if(dur >= 0.)
+			std::format_to(std::back_inserter(str), ",\"dur\":{:.1f}", dur);
+		firstEvent = false;
+	};
+	size_t frame{};
+	SteadyClockTimePoint base{};
+	forEachEntry([&](const FrameTraceEntry &e)
+	{
+		if(!frame)
+			base = e.startOfFrame;
+		auto start = toMicros(e.startOfFrame, base);
+		addEvent("frame", 'X', start, toMicros(e.endOfFrame - e.startOfFrame));
+		std::format_to(std::back_inserter(str), ",\"args\":{{\"frame\":{}}}}}", frame++);
+		if(hasTime(e.startOfEmulation))
+		{
+			auto emulateEnd = hasTime(e.waitForPresent) ? e.waitForPresent : e.endOfFrame;
+			addEvent("emulate", 'X', toMicros(e.startOfEmulation, base), toMicros(emulateEnd - e.startOfEmulation));
+			str += '}';
+		}
+		if(hasTime(e.startOfVideoUpload))
+		{
+			addEvent("videoUpload", 'X', toMicros(e.startOfVideoUpload, base), toMicros(e.videoUpload));
+			str += '}';
+		}
+		if(hasTime(e.waitForPresent))
+		{
+			addEvent("present", 'X', toMicros(e.waitForPresent, base), toMicros(e.endOfFrame - e.waitForPresent));
+			str += '}';
+		}
+		addEvent("audioBuffered", 'C', start);
+		std::format_to(std::back_inserter(str), ",\"args\":{{\"frames\":{}}}}}", e.audioFramesBuffered);
+		if(e.audioUnderruns)
+		{
+			addEvent("audioUnderrun", 'i', start);
+			std::format_to(std::back_inserter(str), ",\"s\":\"p\",\"args\":{{\"count\":{}}}}}", e.audioUnderruns);
+		}
+	});
+	str += "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return str;
+}
+
+}
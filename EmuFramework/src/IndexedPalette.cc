@@ -0,0 +1,72 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/IndexedPalette.hh>
+#include <imagine/util/ranges.hh>
+
+namespace EmuEx
+{
+
+void IndexedPalette::setFormat(PixelFormat newFmt)
+{
+	fmt = newFmt;
+}
+
+void IndexedPalette::setColor(uint8_t idx, uint8_t r, uint8_t g, uint8_t b)
+{
+	auto desc32 = fmt == PixelFmtBGRA8888 ? PixelDescBGRA8888Native : PixelDescRGBA8888Native;
+	col16[idx] = PixelDescRGB565.build(r >> 3, g >> 2, b >> 3, 0);
+	col32[idx] = desc32.build(r, g, b, (uint8_t)0);
+}
+
+// A plain per-pixel lookup keeps the table in L1, a 64K-entry pixel pair table
+// and multi-index loads measured no faster for a 256x240 frame
+template<class T>
+void IndexedPalette::writeLine(T *dest, const uint8_t *src, int pixels, const std::array<T, 256> &col)
+{
+	for(auto i : iotaCount(pixels))
+	{
+		dest[i] = col[src[i]];
+	}
+}
+
+void IndexedPalette::write(MutablePixmapView dest, PixmapView src)
+{
+	assumeExpr(src.format().bytesPerPixel() == 1);
+	assumeExpr(dest.size() == src.size());
+	auto srcData = (const uint8_t*)src.data();
+	auto destData = (char*)dest.data();
+	if(dest.format().bytesPerPixel() == 2)
+	{
+		for([[maybe_unused]] auto h : iotaCount(src.h()))
+		{
+			writeLine((uint16_t*)destData, srcData, src.w(), col16);
+			srcData += src.pitchBytes();
+			destData += dest.pitchBytes();
+		}
+	}
+	else
+	{
+		assumeExpr(dest.format().bytesPerPixel() == 4);
+		for([[maybe_unused]] auto h : iotaCount(src.h()))
+		{
+			writeLine((uint32_t*)destData, srcData, src.w(), col32);
+			srcData += src.pitchBytes();
+			destData += dest.pitchBytes();
+		}
+	}
+}
+
+}
@@ -17,7 +17,11 @@
 #include <emuframework/EmuApp.hh>
 #include <emuframework/Option.hh>
 #include <emuframework/EmuOptions.hh>
+#include <imagine/util/math.hh>
+#include <imagine/util/ranges.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
 
 namespace EmuEx
 {
@@ -39,11 +43,101 @@ RewindManager::RewindManager(EmuApp &app):
 		}
 	} {}
 
+// Delta format: [uint32 previous state size] followed by runs of
+// [uint32 unchanged word count][uint32 changed word count][XOR of each changed word]
+
+static uint8_t *writeU32(uint8_t *out, uint32_t val)
+{
+	memcpy(out, &val, sizeof(val));
+	return out + sizeof(val);
+}
+
+static uint32_t readU32(const uint8_t *&in)
+{
+	uint32_t val;
+	memcpy(&val, in, sizeof(val));
+	in += sizeof(val);
+	return val;
+}
+
+static size_t maxDeltaSize(size_t words)
+{
+	// worst case alternates between single unchanged & changed words
+	return sizeof(uint32_t) + (words / 2 + 2) * sizeof(uint32_t) * 2 + words * sizeof(uint64_t);
+}
+
+static size_t encodeXorDelta(uint8_t *out, const uint64_t *prev, const uint64_t *next, size_t words, uint32_t prevSize)
+{
+	auto outStart = out;
+	out = writeU32(out, prevSize);
+	size_t i = 0;
+	while(i < words)
+	{
+		auto unchangedStart = i;
+		while(i < words && prev[i] == next[i])
+			i++;
+		if(i == words)
+			break;
+		auto changedStart = i;
+		while(i < words && prev[i] != next[i])
+			i++;
+		out = writeU32(out, changedStart - unchangedStart);
+		out = writeU32(out, i - changedStart);
+		for(auto idx = changedStart; idx < i; idx++)
+		{
+			uint64_t x = prev[idx] ^ next[idx];
+			memcpy(out, &x, sizeof(x));
+			out += sizeof(x);
+		}
+	}
+	return out - outStart;
+}
+
+static size_t applyXorDelta(uint64_t *state, size_t words, std::span<const uint8_t> delta)
+{
+	auto in = delta.data();
+	auto end = in + delta.size();
+	auto prevSize = readU32(in);
+	size_t i = 0;
+	while(in < end)
+	{
+		i += readU32(in);
+		auto changed = readU32(in);
+		assumeExpr(i + changed <= words);
+		for(auto _ : iotaCount(changed))
+		{
+			uint64_t x;
+			memcpy(&x, in, sizeof(x));
+			in += sizeof(x);
+			state[i++] ^= x;
+		}
+	}
+	return prevSize;
+}
+
+static std::span<uint8_t> asBytes(DynArray<uint64_t> &arr)
+{
+	return {reinterpret_cast<uint8_t*>(arr.data()), arr.size() * sizeof(uint64_t)};
+}
+
+RewindManager::~RewindManager()
+{
+	stopDeltaThread();
+}
+
 void RewindManager::clear()
 {
 	saveTimer.cancel();
-	stateEntries = {};
-	stateIdx = 0;
+	stopDeltaThread();
+	lastState = {};
+	pendingState = {};
+	deltaBuff = {};
+	deltas = {};
+	lastStateSize = 0;
+	deltaIdx = 0;
+	deltaCount = 0;
+	framesSinceSave = 0;
+	isRewinding = false;
 	stateSize = 0;
 }
 
@@ -51,12 +145,32 @@ bool RewindManager::reset()
 {
 	if(!stateSize)
 		return true;
+	waitForDeltaThread();
 	try
 	{
-		if(maxStates)
-			log.info("allocating {} states of size:{}", maxStates, stateSize);
-		stateEntries.reset(maxStates, stateSize);
-		stateIdx = 0;
+		deltas = {};
+		lastStateSize = 0;
+		deltaIdx = 0;
+		deltaCount = 0;
+		framesSinceSave = 0;
+		if(!maxStates)
+		{
+			stopDeltaThread();
+			lastState = {};
+			pendingState = {};
+			deltaBuff = {};
+			return true;
+		}
+		log.info("allocating buffers for {} states of size:{}", maxStates, stateSize);
+		auto words = divRoundUp(stateSize, sizeof(StateWord));
+		lastState.reset(words);
+		pendingState.reset(words);
+		deltaBuff.resetForOverwrite(maxDeltaSize(words));
+		deltas = std::vector<DynArray<uint8_t>>(maxStates - 1);
+		if(frameInterval)
+			startDeltaThread();
+		else
+			stopDeltaThread();
 		return true;
 	}
 	catch(...)
@@ -68,31 +182,183 @@ bool RewindManager::reset()
 void RewindManager::saveState(EmuApp &app)
 {
 	assumeExpr(maxStates);
-	assumeExpr(stateIdx < maxStates);
-	//log.debug("saving rewind state index:{}", stateIdx);
-	auto &entry = stateEntries[stateIdx];
-	stateIdx = stateIdx + 1 == maxStates ? 0 : stateIdx + 1;
-	entry.size = app.writeState({entry.data, stateSize}, {.uncompressed = true});
+	auto suspendCtx = app.suspendEmulationThread();
+	captureState(app.system());
+}
+
+void RewindManager::onFramesAdvanced(EmuSystem &sys, int frames)
+{
+	if(!frameInterval || !lastState.size())
+		return;
+	framesSinceSave += frames;
+	if(framesSinceSave < frameInterval)
+		return;
+	framesSinceSave = 0;
+	captureState(sys);
+}
+
+void RewindManager::captureState(EmuSystem &sys)
+{
+	if(deltaWorkPending.load(std::memory_order::acquire))
+	{
+		log.debug("delta thread still busy, skipping state");
+		return;
+	}
+	auto stateBuff = asBytes(pendingState);
+	pendingStateSize = sys.writeState(stateBuff.first(stateSize), {.uncompressed = true});
+	// keep the padding zeroed so it never shows up in a delta
+	std::fill(stateBuff.begin() + pendingStateSize, stateBuff.end(), 0);
+	if(!deltaThread.joinable())
+	{
+		// timer captures already run with the emulation suspended
+		commitPendingState();
+		return;
+	}
+	deltaWorkPending.store(true, std::memory_order::release);
+	deltaWorkSem.release();
+}
+
+void RewindManager::commitPendingState()
+{
+	if(lastStateSize && deltas.size())
+	{
+		auto deltaSize = encodeXorDelta(deltaBuff.data(), lastState.data(), pendingState.data(), lastState.size(), lastStateSize);
+		pushDelta({deltaBuff.data(), deltaSize});
+	}
+	std::swap(lastState, pendingState);
+	lastStateSize = pendingStateSize;
+	//log.debug("saved rewind state, {} deltas using {} bytes", deltaCount, deltaBytes());
+}
+
+void RewindManager::pushDelta(std::span<const uint8_t> delta)
+{
+	// when the ring is full the slot at deltaIdx holds the oldest delta
+	auto &entry = deltas[deltaIdx];
+	try
+	{
+		entry = dynArrayForOverwrite<uint8_t>(delta.size());
+	}
+	catch(...)
+	{
+		log.error("out of memory for delta of size:{}, dropping older states", delta.size());
+		for(auto &d : deltas) { d = {}; }
+		deltaIdx = 0;
+		deltaCount = 0;
+		return;
+	}
+	std::ranges::copy(delta, entry.data());
+	deltaIdx = deltaIdx + 1 == deltas.size() ? 0 : deltaIdx + 1;
+	deltaCount = std::min(deltaCount + 1, deltas.size());
+}
+
+std::span<uint8_t> RewindManager::popState(bool keepOldest)
+{
+	waitForDeltaThread();
+	if(!lastStateSize)
+		return {};
+	// the system may modify the buffer while reading so restore from a copy
+	std::ranges::copy(lastState, pendingState.data());
+	auto size = lastStateSize;
+	if(deltaCount)
+	{
+		deltaIdx = deltaIdx ? deltaIdx - 1 : deltas.size() - 1;
+		auto &entry = deltas[deltaIdx];
+		lastStateSize = applyXorDelta(lastState.data(), lastState.size(), entry.span());
+		entry = {};
+		deltaCount--;
+	}
+	else if(!keepOldest)
+	{
+		lastStateSize = 0;
+	}
+	return asBytes(pendingState).first(size);
 }
 
 void RewindManager::rewindState(EmuApp &app)
 {
 	if(!maxStates)
 		return;
-	assumeExpr(stateIdx < maxStates);
-	auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
-	auto &entry = stateEntries[prevIdx];
-	if(!entry.size)
+	auto state = popState(false);
+	if(state.empty())
 		return;
-	log.info("rewinding to state index:{}", prevIdx);
-	app.readState({entry.data, std::exchange(entry.size, 0)});
-	stateIdx = prevIdx;
+	log.info("rewinding state, {} older states remaining using {} bytes", deltaCount, deltaBytes());
+	app.readState(state);
 	saveTimer.reset();
 }
 
+bool RewindManager::stepBack(EmuApp &app)
+{
+	// called from the emulation thread while rewind is held, the oldest
+	// state is kept so holding past the end of the history stays on it
+	if(!maxStates)
+		return false;
+	auto state = popState(true);
+	if(state.empty())
+		return false;
+	app.system().readState(app, state);
+	framesSinceSave = 0;
+	return true;
+}
+
+void RewindManager::startDeltaThread()
+{
+	if(deltaThread.joinable())
+		return;
+	deltaThread = std::thread{[this]
+	{
+		while(true)
+		{
+			deltaWorkSem.acquire();
+			if(deltaThreadQuit)
+				return;
+			commitPendingState();
+			deltaWorkPending.store(false, std::memory_order::release);
+			deltaWorkPending.notify_all();
+		}
+	}};
+}
+
+void RewindManager::stopDeltaThread()
+{
+	if(!deltaThread.joinable())
+		return;
+	waitForDeltaThread();
+	deltaThreadQuit = true;
+	deltaWorkSem.release();
+	deltaThread.join();
+	deltaThreadQuit = false;
+}
+
+void RewindManager::waitForDeltaThread()
+{
+	deltaWorkPending.wait(true, std::memory_order::acquire);
+}
+
+size_t RewindManager::deltaBytes() const
+{
+	size_t bytes{};
+	for(const auto &d : deltas) { bytes += d.size(); }
+	return bytes;
+}
+
+void RewindManager::setFrameInterval(uint8_t interval)
+{
+	frameInterval = interval;
+	if(frameInterval)
+	{
+		saveTimer.cancel();
+		if(lastState.size())
+			startDeltaThread();
+	}
+	else
+	{
+		stopDeltaThread(); // the timer is started again when the emulation resumes
+	}
+}
+
 void RewindManager::startTimer()
 {
-	if(!stateEntries.size())
+	if(!lastState.size() || frameInterval)
 		return;
 	saveTimer.start();
 }
@@ -113,6 +379,7 @@ bool RewindManager::readConfig(MapIO &io, unsigned key)
 			if(s > 0)
 				saveTimer.frequency = Seconds{s};
 		});
+		case CFGKEY_REWIND_FRAME_INTERVAL: return readOptionValue<uint8_t>(io, [&](auto f){ frameInterval = f; });
 	}
 }
 
@@ -120,6 +387,7 @@ void RewindManager::writeConfig(FileIO &io) const
 {
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_STATES, uint32_t(maxStates), 0u);
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_TIMER_SECS, int16_t(saveTimer.frequency.count()), defaultSaveFreq.count());
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_FRAME_INTERVAL, frameInterval, uint8_t{});
 }
 
 
@@ -0,0 +1,125 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/logger/logger.h>
+#include <format>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"Screenshot"};
+
+ScreenshotWriter::~ScreenshotWriter()
+{
+	if(!thread.joinable())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quit = true;
+	}
+	jobCond.notify_one();
+	thread.join();
+}
+
+void ScreenshotWriter::request(int frames)
+{
+	framesLeft.store(frames, std::memory_order_relaxed);
+}
+
+MemPixmap ScreenshotWriter::takePixmap(PixmapDesc desc)
+{
+	std::scoped_lock lock{mutex};
+	if(freePixmaps.size())
+	{
+		auto pix = std::move(freePixmaps.back());
+		freePixmaps.pop_back();
+		if(pix.desc() != desc)
+			pix = {desc};
+		return pix;
+	}
+	if(allocatedPixmaps == maxPendingFrames)
+		return {};
+	allocatedPixmaps++;
+	return {desc};
+}
+
+void ScreenshotWriter::capture(PixmapView srcPix)
+{
+	// decrement atomically so a request() from the UI thread isn't overwritten
+	auto left = framesLeft.load(std::memory_order_relaxed);
+	do
+	{
+		if(!left)
+			return;
+	} while(!framesLeft.compare_exchange_weak(left, left - 1, std::memory_order_relaxed));
+	bool isBurst = frameIdx || left > 1;
+	bool isLast = left == 1;
+	if(!frameIdx)
+		basePath = app.makeNextScreenshotFilename();
+	FS::PathString path = isBurst ?
+		FS::PathString{std::format("{}-{:03}.png", std::string_view{basePath}.substr(0, basePath.size() - 4), frameIdx)} :
+		basePath;
+	frameIdx = isLast ? 0 : frameIdx + 1;
+	auto pix = takePixmap(srcPix.desc());
+	if(!pix)
+	{
+		log.warn("dropped frame:{}, all buffers pending", path);
+		if(!isLast)
+			return;
+	}
+	else
+	{
+		pix.view().write(srcPix);
+	}
+	if(!thread.joinable())
+	{
+		thread = std::thread{[this]{ run(); }};
+	}
+	{
+		std::scoped_lock lock{mutex};
+		jobs.emplace_back(std::move(pix), std::move(path), isLast);
+	}
+	jobCond.notify_one();
+}
+
+void ScreenshotWriter::run()
+{
+	std::unique_lock lock{mutex};
+	while(true)
+	{
+		jobCond.wait(lock, [&]{ return quit || jobs.size(); });
+		if(jobs.empty())
+			return;
+		auto job = std::move(jobs.front());
+		jobs.pop_front();
+		lock.unlock();
+		// a missing buffer means the frame was dropped
+		bool success = job.pix && app.writeScreenshot(job.pix.view(), job.path);
+		lock.lock();
+		hadError |= !success;
+		if(job.pix)
+			freePixmaps.emplace_back(std::move(job.pix));
+		if(job.isLast)
+		{
+			app.systemTask.sendScreenshotReply(!hadError);
+			hadError = false;
+		}
+	}
+}
+
+}
@@ -0,0 +1,264 @@
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/StateCodec.hh>
+#include <imagine/logger/logger.h>
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"StateCodec"};
+
+// on-disk layout, all values little endian:
+// magic[8], codec(u8), reserved[3], blockSize(u32), uncompressedSize(u64), blocks(u32),
+// compressed block sizes(u32 * blocks), block data
+constexpr uint8_t stateMagic[8]{'E', 'X', 'S', 'T', 'A', 'T', 'E', 0x1A};
+constexpr size_t headerSize = 28;
+constexpr int deflateLevel = Z_BEST_SPEED;
+constexpr unsigned maxWorkers = 4;
+constexpr size_t maxBlockSize = 64 * 1024 * 1024;
+
+static void putLE(uint8_t *p, std::unsigned_integral auto v)
+{
+	for(size_t i = 0; i < sizeof(v); i++)
+		p[i] = v >> (i * 8);
+}
+
+template<class T>
+static T getLE(const uint8_t *p)
+{
+	T v{};
+	for(size_t i = 0; i < sizeof(T); i++)
+		v |= T(p[i]) << (i * 8);
+	return v;
+}
+
+// Helper threads that stay alive between calls so each save or load doesn't pay for thread startup,
+// the calling thread also works on blocks and only one job runs at a time
+class BlockWorkers
+{
+public:
+	BlockWorkers(size_t threadCount)
+	{
+		threads.reserve(threadCount);
+		for(size_t i = 0; i < threadCount; i++)
+			threads.emplace_back([this]{ run(); });
+	}
+
+	~BlockWorkers()
+	{
+		{
+			std::scoped_lock lock{mutex};
+			quit = true;
+		}
+		jobCond.notify_all();
+		for(auto &t : threads)
+			t.join();
+	}
+
+	size_t threadCount() const { return threads.size(); }
+
+	void forEach(size_t blocks, const std::function<void(size_t)> &func)
+	{
+		std::scoped_lock jobLock{jobMutex};
+		{
+			std::scoped_lock lock{mutex};
+			job = &func;
+			jobBlocks = blocks;
+			nextBlock.store(0, std::memory_order_relaxed);
+			activeWorkers = threads.size();
+			jobId++;
+		}
+		jobCond.notify_all();
+		runBlocks();
+		std::unique_lock lock{mutex};
+		doneCond.wait(lock, [&]{ return !activeWorkers; });
+		job = {};
+	}
+
+private:
+	std::vector<std::thread> threads;
+	std::mutex jobMutex;
+	std::mutex mutex;
+	std::condition_variable jobCond;
+	std::condition_variable doneCond;
+	const std::function<void(size_t)> *job{};
+	size_t jobBlocks{};
+	std::atomic_size_t nextBlock{};
+	size_t activeWorkers{};
+	uint32_t jobId{};
+	bool quit{};
+
+	void runBlocks()
+	{
+		for(auto i = nextBlock++; i < jobBlocks; i = nextBlock++)
+			(*job)(i);
+	}
+
+	void run()
+	{
+		uint32_t lastJobId{};
+		std::unique_lock lock{mutex};
+		while(true)
+		{
+			jobCond.wait(lock, [&]{ return quit || jobId != lastJobId; });
+			if(quit)
+				return;
+			lastJobId = jobId;
+			lock.unlock();
+			runBlocks();
+			lock.lock();
+			if(!--activeWorkers)
+				doneCond.notify_all();
+		}
+	}
+};
+
+// Runs func(blockIdx) for every block, spreading them over the worker threads when there's more than one
+static void forEachBlock(size_t blocks, const std::function<void(size_t)> &func)
+{
+	static BlockWorkers workers{std::min(size_t(std::max(std::thread::hardware_concurrency(), 1u)), size_t(maxWorkers)) - 1};
+	if(blocks <= 1 || !workers.threadCount())
+	{
+		for(size_t i = 0; i < blocks; i++)
+			func(i);
+		return;
+	}
+	workers.forEach(blocks, func);
+}
+
+static size_t deflateBlock(std::span<uint8_t> dest, std::span<const uint8_t> src)
+{
+	z_stream s{};
+	if(deflateInit2(&s, deflateLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return 0;
+	s.avail_in = src.size();
+	s.next_in = const_cast<z_const Bytef*>(src.data());
+	s.avail_out = dest.size();
+	s.next_out = dest.data();
+	auto res = deflate(&s, Z_FINISH);
+	deflateEnd(&s);
+	return res == Z_STREAM_END ? s.total_out : 0;
+}
+
+static bool inflateBlock(std::span<uint8_t> dest, std::span<const uint8_t> src)
+{
+	z_stream s{};
+	if(inflateInit2(&s, -MAX_WBITS) != Z_OK)
+		return false;
+	s.avail_in = src.size();
+	s.next_in = const_cast<z_const Bytef*>(src.data());
+	s.avail_out = dest.size();
+	s.next_out = dest.data();
+	auto res = inflate(&s, Z_FINISH);
+	inflateEnd(&s);
+	return res == Z_STREAM_END && s.total_out == dest.size();
+}
+
+bool hasStateCodecHeader(std::span<const uint8_t> buff)
+{
+	return buff.size() >= headerSize && std::equal(std::begin(stateMagic), std::end(stateMagic), buff.begin());
+}
+
+DynArray<uint8_t> compressState(std::span<const uint8_t> src, StateCodec codec)
+{
+	if(codec != StateCodec::Deflate)
+		throw std::runtime_error("Unsupported state codec");
+	auto blocks = (src.size() + stateCodecBlockSize - 1) / stateCodecBlockSize;
+	auto tableSize = blocks * sizeof(uint32_t);
+	// compress each block into a slot sized for its worst case, then pack them together
+	std::vector<size_t> slotOffsets(blocks + 1);
+	slotOffsets[0] = headerSize + tableSize;
+	for(size_t i = 0; i < blocks; i++)
+	{
+		auto blockBytes = std::min(stateCodecBlockSize, src.size() - i * stateCodecBlockSize);
+		slotOffsets[i + 1] = slotOffsets[i] + compressBound(blockBytes);
+	}
+	auto arr = dynArrayForOverwrite<uint8_t>(slotOffsets[blocks]);
+	std::vector<size_t> compSizes(blocks);
+	forEachBlock(blocks, [&](size_t i)
+	{
+		auto blockSrc = src.subspan(i * stateCodecBlockSize, std::min(stateCodecBlockSize, src.size() - i * stateCodecBlockSize));
+		compSizes[i] = deflateBlock({arr.data() + slotOffsets[i], slotOffsets[i + 1] - slotOffsets[i]}, blockSrc);
+	});
+	auto p = arr.data();
+	std::copy(std::begin(stateMagic), std::end(stateMagic), p);
+	p[8] = uint8_t(codec);
+	std::fill_n(p + 9, 3, 0);
+	putLE(p + 12, uint32_t(stateCodecBlockSize));
+	putLE(p + 16, uint64_t(src.size()));
+	putLE(p + 24, uint32_t(blocks));
+	auto dataOffset = slotOffsets[0];
+	for(size_t i = 0; i < blocks; i++)
+	{
+		if(!compSizes[i])
+			throw std::runtime_error("Error compressing state");
+		putLE(p + headerSize + i * sizeof(uint32_t), uint32_t(compSizes[i]));
+		memmove(p + dataOffset, p + slotOffsets[i], compSizes[i]);
+		dataOffset += compSizes[i];
+	}
+	arr.trim(dataOffset);
+	log.debug("compressed {} byte state to {} bytes in {} blocks", src.size(), dataOffset, blocks);
+	return arr;
+}
+
+DynArray<uint8_t> uncompressState(std::span<const uint8_t> buff)
+{
+	if(!hasStateCodecHeader(buff))
+		throw std::runtime_error("Missing state header");
+	auto p = buff.data();
+	auto codec = StateCodec(p[8]);
+	if(codec != StateCodec::Deflate)
+		throw std::runtime_error("Unsupported state codec");
+	size_t blockSize = getLE<uint32_t>(p + 12);
+	auto uncompSize = getLE<uint64_t>(p + 16);
+	size_t blocks = getLE<uint32_t>(p + 24);
+	if(!blockSize || blockSize > maxBlockSize || blocks != (uncompSize + blockSize - 1) / blockSize
+		|| headerSize + blocks * sizeof(uint32_t) > buff.size())
+		throw std::runtime_error("Invalid state header");
+	std::vector<size_t> offsets(blocks + 1);
+	offsets[0] = headerSize + blocks * sizeof(uint32_t);
+	for(size_t i = 0; i < blocks; i++)
+	{
+		offsets[i + 1] = offsets[i] + getLE<uint32_t>(p + headerSize + i * sizeof(uint32_t));
+	}
+	if(offsets[blocks] > buff.size())
+		throw std::runtime_error("Truncated state data");
+	auto arr = dynArrayForOverwrite<uint8_t>(uncompSize);
+	std::atomic_bool hasError{};
+	forEachBlock(blocks, [&](size_t i)
+	{
+		std::span<uint8_t> dest{arr.data() + i * blockSize, std::min(blockSize, size_t(uncompSize - i * blockSize))};
+		if(!inflateBlock(dest, buff.subspan(offsets[i], offsets[i + 1] - offsets[i])))
+			hasError = true;
+	});
+	if(hasError)
+		throw std::runtime_error("Error uncompressing state");
+	return arr;
+}
+
+}
@@ -104,6 +104,15 @@ AudioOptionView::AudioOptionView(ViewAttachParams attach, EmuAudio& audio_, bool
 			audio.addSoundBuffersOnUnderrunSetting = item.flipBoolValue(*this);
 		}
 	},
+	dynamicRateControl
+	{
+		"Dynamic Rate Control", attach,
+		audio_.dynamicRateControl,
+		[this](BoolMenuItem &item)
+		{
+			audio.dynamicRateControl = item.flipBoolValue(*this);
+		}
+	},
 	audioRateItem
 	{
 		[&]
@@ -186,6 +195,7 @@ void AudioOptionView::loadStockItems()
 	}
 	item.emplace_back(&soundBuffers);
 	item.emplace_back(&addSoundBuffersOnUnderrun);
+	item.emplace_back(&dynamicRateControl);
 	if constexpr(IG::Audio::Manager::HAS_SOLO_MIX)
 	{
 		item.emplace_back(&audioSoloMix);
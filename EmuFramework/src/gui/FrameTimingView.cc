@@ -58,6 +58,29 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().frameInterval.setUnchecked(item.id); }
 		},
 	},
+	runAheadItems
+	{
+		{"Off", attach, {.id = 0}},
+		{"1",   attach, {.id = 1}},
+		{"2",   attach, {.id = 2}},
+		{"3",   attach, {.id = 3}},
+		{"4",   attach, {.id = 4}},
+	},
+	runAhead
+	{
+		"Run-ahead Frames", attach,
+		MenuId{app().runAheadFrames},
+		runAheadItems,
+		MultiChoiceMenuItem::Config
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item, const Input::Event &e)
+			{
+				app().runAheadFrames.setUnchecked(item.id);
+				if(app().system().onRunAheadOrRewindChanged(app()))
+					app().promptSystemReloadDueToSetOption(attachParams(), e);
+			}
+		},
+	},
 	frameRateItems
 	{
 		{"Auto (Match screen when rates are similar)", attach,
@@ -137,6 +160,24 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().showFrameTimingStats,
 		[this](BoolMenuItem &item) { app().showFrameTimingStats = item.flipBoolValue(*this); }
 	},
+	recordFrameTrace
+	{
+		"Record Frame Trace", attach,
+		app().frameTrace.isEnabled(),
+		[this](BoolMenuItem &item)
+		{
+			auto suspendCtx = app().suspendEmulationThread();
+			bool on = item.flipBoolValue(*this);
+			if(on) // only count underruns from the start of the trace
+				app().audio.takeUnderruns();
+			app().frameTrace.setEnabled(on);
+		}
+	},
+	exportFrameTrace
+	{
+		"Export Frame Trace", attach,
+		[this]() { app().exportFrameTrace(); }
+	},
 	lowLatencyVideo
 	{
 		"Low Latency Mode", attach,
@@ -265,6 +306,7 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 void FrameTimingView::loadStockItems()
 {
 	item.emplace_back(&frameInterval);
+	item.emplace_back(&runAhead);
 	item.emplace_back(&frameRate);
 	if(EmuSystem::hasPALVideoSystem)
 	{
@@ -273,6 +315,8 @@ void FrameTimingView::loadStockItems()
 	if(app().emuWindow().supportsFrameClockSource(FrameClockSource::Screen))
 		item.emplace_back(&outputRateMode);
 	item.emplace_back(&frameTimingStats);
+	item.emplace_back(&recordFrameTrace);
+	item.emplace_back(&exportFrameTrace);
 	item.emplace_back(&advancedHeading);
 	item.emplace_back(&frameClock);
 	if(used(presentMode))
@@ -39,11 +39,15 @@ protected:
 	static constexpr size_t maxFrameClockItems = 4;
 	TextMenuItem frameIntervalItem[5];
 	MultiChoiceMenuItem frameInterval;
+	TextMenuItem runAheadItems[5];
+	MultiChoiceMenuItem runAhead;
 	TextMenuItem frameRateItems[3];
 	VideoSystem activeVideoSystem{};
 	MultiChoiceMenuItem frameRate;
 	MultiChoiceMenuItem frameRatePAL;
 	BoolMenuItem frameTimingStats;
+	BoolMenuItem recordFrameTrace;
+	TextMenuItem exportFrameTrace;
 	BoolMenuItem lowLatencyVideo;
 	StaticArrayList<TextMenuItem, maxFrameClockItems> frameClockItems;
 	MultiChoiceMenuItem frameClock;
@@ -55,7 +59,7 @@ protected:
 	ConditionalMember<Config::multipleScreenFrameRates, MultiChoiceMenuItem> screenFrameRate;
 	BoolMenuItem blankFrameInsertion;
 	TextHeadingMenuItem advancedHeading;
-	StaticArrayList<MenuItem*, 11> item;
+	StaticArrayList<MenuItem*, 14> item;
 
 	bool onFrameRateChange(VideoSystem, SteadyClockDuration);
 };
@@ -45,6 +45,12 @@ LoadProgressView::LoadProgressView(ViewAttachParams attach, const Input::Event &
 						msgs.readExtraData(std::span{errorStr, len});
 						msgPort.detach();
 						auto &app = this->app();
+						if(app.isRunningCommandBenchmark())
+						{
+							log.error("benchmark content failed to load:{}", std::string_view{errorStr, len});
+							appContext().exit(1);
+							return;
+						}
 						app.popModalViews();
 						app.postErrorMessage(4, std::string_view{errorStr, len});
 						return;
@@ -60,6 +66,15 @@ LoadProgressView::LoadProgressView(ViewAttachParams attach, const Input::Event &
 						onComplete(originalEvent);
 						return;
 					}
+					case EmuSystem::LoadProgress::CANCELED:
+					{
+						msgPort.detach();
+						auto &app = this->app();
+						app.popModalViews();
+						app.closeSystem();
+						log.info("loading canceled");
+						return;
+					}
 					case EmuSystem::LoadProgress::UPDATE:
 					{
 						setPos(msg.intArg);
@@ -84,6 +99,8 @@ LoadProgressView::LoadProgressView(ViewAttachParams attach, const Input::Event &
 								log.info("set custom string:{}", labelStr);
 							}
 						}
+						if(isCanceled())
+							setLabel("Canceling...");
 						place();
 						postDraw();
 						break;
@@ -127,6 +144,22 @@ void LoadProgressView::place()
 	updateProgressRect();
 }
 
+bool LoadProgressView::inputEvent(const Input::Event &e, ViewInputEventParams)
+{
+	if(e.keyEvent() && e.keyEvent()->pushed(Input::DefaultKey::CANCEL))
+	{
+		if(!canceled.exchange(true, std::memory_order_relaxed))
+		{
+			log.info("canceling load");
+			setLabel("Canceling...");
+			place();
+			postDraw();
+		}
+		return true;
+	}
+	return false;
+}
+
 void LoadProgressView::draw(Gfx::RendererCommands&__restrict__ cmds, ViewDrawParams) const
 {
 	if(!text.isVisible())
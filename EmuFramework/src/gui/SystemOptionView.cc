@@ -20,6 +20,7 @@
 #include "CPUAffinityView.hh"
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/gui/TextTableView.hh>
+#include <imagine/gui/AlertView.hh>
 #include <imagine/fs/FS.hh>
 #include <format>
 
@@ -189,6 +190,8 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 					[this](CollectTextInputView &, auto val)
 					{
 						app().rewindManager.updateMaxStates(val);
+						if(app().system().onRunAheadOrRewindChanged(app()))
+							app().postMessage(4, false, "Restart the system to apply this change");
 						rewindStates.setSelected(val, *this);
 						dismissPrevious();
 						return true;
@@ -208,10 +211,12 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 				t.resetString(std::format("{}", app().rewindManager.maxStates));
 				return true;
 			},
-			.defaultItemOnSelect = [this](TextMenuItem &item)
+			.defaultItemOnSelect = [this](TextMenuItem &item, const Input::Event &e)
 			{
 				app().rewindManager.updateMaxStates(item.id);
 				app().defaultVController().updateEnabledUIButtons();
+				if(app().system().onRunAheadOrRewindChanged(app()))
+					app().promptSystemReloadDueToSetOption(attachParams(), e);
 			}
 		},
 	},
@@ -230,6 +235,25 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 				});
 		}
 	},
+	rewindFrameInterval
+	{
+		"State Interval (Frames)", std::to_string(app().rewindManager.frameInterval), attach,
+		[this](const Input::Event &e)
+		{
+			pushAndShowNewCollectValueRangeInputView<int, 0, 60>(attachParams(), e,
+				"Input 0 to 60, 0 uses the seconds interval", std::to_string(app().rewindManager.frameInterval),
+				[this](CollectTextInputView &, auto val)
+				{
+					{
+						// read by the emulation thread after each frame
+						auto suspendCtx = app().suspendEmulationThread();
+						app().rewindManager.setFrameInterval(val);
+					}
+					rewindFrameInterval.set2ndName(std::to_string(val));
+					return true;
+				});
+		}
+	},
 	performanceMode
 	{
 		"Performance Mode", attach,
@@ -257,6 +281,22 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			pushAndShow(makeView<CPUAffinityView>(appContext().cpuCount()), e);
 		}
 	},
+	clearArchiveCache
+	{
+		"Clear Archive Cache", attach,
+		[this](const Input::Event &e)
+		{
+			pushAndShowModal(makeView<YesNoAlertView>("Really delete all content extracted from archives? It will be extracted again on next load.",
+				YesNoAlertView::Delegates
+				{
+					.onYes = [this]
+					{
+						app().archiveCache.clear();
+						app().postMessage("Cleared archive cache");
+					}
+				}), e);
+		}
+	},
 	autosaveHeading{"Autosave Options", attach},
 	rewindHeading{"Rewind Options", attach},
 	otherHeading{"Other Options", attach}
@@ -276,6 +316,7 @@ void SystemOptionView::loadStockItems()
 	item.emplace_back(&rewindHeading);
 	item.emplace_back(&rewindStates);
 	item.emplace_back(&rewindTimeInterval);
+	item.emplace_back(&rewindFrameInterval);
 	item.emplace_back(&otherHeading);
 	item.emplace_back(&confirmOverwriteState);
 	item.emplace_back(&fastModeSpeed);
@@ -286,6 +327,7 @@ void SystemOptionView::loadStockItems()
 		item.emplace_back(&noopThread);
 	if(used(cpuAffinity) && appContext().cpuCount() > 1)
 		item.emplace_back(&cpuAffinity);
+	item.emplace_back(&clearArchiveCache);
 }
 
 }
@@ -15,12 +15,19 @@
 
 #include "ArchiveVFS.hh"
 #include <mednafen/MemoryStream.h>
+#include <mednafen/FileStream.h>
+#include <emuframework/ArchiveCache.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/fs/FS.hh>
 #include <imagine/io/MapIO.hh>
 #include <imagine/util/format.hh>
 #include <imagine/logger/logger.h>
 
+namespace EmuEx
+{
+IG::ApplicationContext gAppContext();
+}
+
 namespace Mednafen
 {
 
@@ -30,11 +37,36 @@ ArchiveVFS::ArchiveVFS(IG::ArchiveIO arch):
 	VirtualFS('/', "/"),
 	arch{std::move(arch)} {}
 
+ArchiveVFS::ArchiveVFS(IG::ArchiveIO arch, EmuEx::ArchiveCache &cache, IG::CStringView archivePath):
+	VirtualFS('/', "/"),
+	arch{std::move(arch)},
+	cache{&cache},
+	archivePath{archivePath}
+{
+	if(auto io = EmuEx::gAppContext().openFileUri(archivePath, {.test = true}))
+		archiveSize = io.size();
+}
+
 Stream* ArchiveVFS::open(const std::string &path, const uint32 mode, const int do_lock, const bool throw_on_noent, const CanaryType canary)
 {
 	assert(mode == MODE_READ);
 	assert(do_lock == 0);
 	seekFile(path);
+	// small files like .cue sheets are just read into memory
+	if(cache && cache->canCache(arch))
+	{
+		try
+		{
+			if(auto file = cache->openEntry(archivePath, archiveSize, arch, IG::IOAccessHint::Sequential))
+				return new FileStream(std::move(file));
+		}
+		catch(std::exception &err)
+		{
+			// entry was partly consumed, find it again and read it into memory
+			log.warn("archive cache error:{}", err.what());
+			seekFile(path);
+		}
+	}
 	auto stream = std::make_unique<MemoryStream>(arch.size(), true);
 	if(arch.read(stream->map(), arch.size()) != ssize_t(arch.size()))
 	{
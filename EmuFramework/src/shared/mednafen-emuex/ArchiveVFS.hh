@@ -17,6 +17,12 @@
 
 #include <mednafen/VirtualFS.h>
 #include <imagine/io/ArchiveIO.hh>
+#include <string>
+
+namespace EmuEx
+{
+class ArchiveCache;
+}
 
 namespace Mednafen
 {
@@ -25,6 +31,9 @@ class ArchiveVFS final : public VirtualFS
 {
 public:
 	ArchiveVFS(IG::ArchiveIO);
+	// Opened files are extracted to the archive cache and memory mapped when possible
+	// instead of being read fully into memory
+	ArchiveVFS(IG::ArchiveIO, EmuEx::ArchiveCache &, IG::CStringView archivePath);
 	Stream* open(const std::string& path, const uint32 mode, const int do_lock = false, const bool throw_on_noent = true, const CanaryType canary = CanaryType::open) final;
 	FILE* openAsStdio(const std::string& path, const uint32 mode) final;
 	int mkdir(const std::string& path, const bool throw_on_exist = false, const bool throw_on_noent = true) final;
@@ -38,6 +47,9 @@ public:
 
 private:
 	IG::ArchiveIO arch;
+	EmuEx::ArchiveCache *cache{};
+	std::string archivePath;
+	size_t archiveSize{};
 
 	void seekFile(const std::string& path);
 };
@@ -14,6 +14,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <mednafen/mednafen.h>
+#include <mednafen/MemoryStream.h>
 #include <mednafen/cdrom/CDAccess.h>
 #include <mednafen/cdrom/CDAccess_Image.h>
 #include <mednafen/cdrom/CDAccess_CCD.h>
@@ -75,9 +76,28 @@ void CDAccess_Image::ImageOpenBinary(VirtualFS* vfs, const std::string& path, bo
 	GenerateTOC();
 }
 
+void CDAccess::HintSequentialRead(int32 lba)
+{
+	if(lba >= read_ahead_start && lba + ReadAheadSectors / 2 < read_ahead_end)
+		return;
+	HintReadSector(lba, ReadAheadSectors);
+	read_ahead_start = lba;
+	read_ahead_end = lba + ReadAheadSectors;
+}
+
+Stream* CDAccess_OpenImageStream(VirtualFS* vfs, const std::string& path, bool image_memcache)
+{
+	Stream* stream = vfs->open(path, VirtualFS::MODE_READ);
+	if(image_memcache && !stream->map())
+		return new MemoryStream(stream);
+	stream->require_fast_seekable();
+	return stream;
+}
+
 static int readSector(auto &cdAccess, uint8 *buf, int32 lba, uint32 size)
 {
 	uint8 data[2352 + 96]{};
+	cdAccess.HintSequentialRead(lba);
 	int format = cdAccess.Read_Raw_Sector(data, lba);
 	switch(format)
 	{
@@ -155,6 +175,7 @@ int CDAccess_CCD::Read_Sector(uint8 *buf, int32 lba, uint32 size)
 	if(lba < 0 || (size_t)lba >= img_numsectors)
 	 return -1;
 
+	HintSequentialRead(lba);
 	img_stream->readAtPos(buf, size, lba * 2352);
 	return 0;
 }
@@ -179,6 +179,8 @@ inline void readStateMDFN(std::span<uint8_t> buff)
 	using namespace Mednafen;
 	if(hasGzipHeader(buff))
 	{
+		// MDFNSS_LoadSM() scans every section header before loading any of them,
+		// so the whole state must be inflated first, do it directly into the stream's buffer
 		MemoryStream s{gzipUncompressedSize(buff), -1};
 		auto outputSize = uncompressGzip({s.map(), size_t(s.size())}, buff);
 		if(!outputSize)
@@ -70,6 +70,10 @@ catch(std::system_error &err)
 FileStream::FileStream(std::span<uint8_t> buff):
 	io{IG::MapIO{buff}} {}
 
+FileStream::FileStream(IG::FileIO io):
+	io{std::move(io)},
+	attribs{ATTRIBUTE_READABLE} {}
+
 FileStream::~FileStream() {}
 
 uint64 FileStream::attributes(void)
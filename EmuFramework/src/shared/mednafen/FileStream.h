@@ -63,6 +63,7 @@ class FileStream : public Stream
 
  FileStream(const std::string& path, const uint32 mode, const int do_lock = false, const uint32 buffer_size = 4096);
  FileStream(std::span<uint8_t> buff);
+ FileStream(IG::FileIO);
  virtual ~FileStream() override;
 
  virtual uint64 attributes(void) override;
@@ -48,12 +48,33 @@ class CDAccess
 
  virtual int Read_Sector(uint8 *buf, int32 lba, uint32 size) = 0;
 
+ // Calls HintReadSector() for the sectors ahead of lba whenever reads leave the
+ // previously hinted window, so memory mapped images are paged in before they're needed
+ void HintSequentialRead(int32 lba);
+
+ static constexpr int32 ReadAheadSectors = 64;
+
  private:
  CDAccess(const CDAccess&);	// No copy constructor.
  CDAccess& operator=(const CDAccess&); // No assignment operator.
+
+ int32 read_ahead_start = 0;
+ int32 read_ahead_end = 0;
 };
 
-CDAccess* CDAccess_Open(VirtualFS* vfs, const std::string& path, bool image_memcache);
+struct CDAccessOptions
+{
+ // CHD images: decompressed hunks kept in the LRU cache and hunks decoded ahead of
+ // the current read direction, read-ahead is skipped when the image is memory cached
+ unsigned chdHunkCacheSize = 16;
+ unsigned chdPrefetchHunks = 4;
+};
+
+CDAccess* CDAccess_Open(VirtualFS* vfs, const std::string& path, bool image_memcache, const CDAccessOptions& opts = {});
+
+// Opens a track/image file, only copying it into memory for image_memcache if the
+// VFS didn't already return a memory mapped stream
+Stream* CDAccess_OpenImageStream(VirtualFS* vfs, const std::string& path, bool image_memcache);
 
 }
 #endif
@@ -245,15 +245,7 @@ void CDAccess_CCD::Load(VirtualFS* vfs, const std::string& path, bool image_memc
  {
   std::string image_path = vfs->eval_fip(dir_path, file_base + "." + img_extsd, true);
 
-  if(image_memcache)
-  {
-   img_stream.reset(new MemoryStream(vfs->open(image_path, VirtualFS::MODE_READ)));
-  }
-  else
-  {
-   img_stream.reset(vfs->open(image_path, VirtualFS::MODE_READ));
-   img_stream->require_fast_seekable();
-  }
+  img_stream.reset(CDAccess_OpenImageStream(vfs, image_path, image_memcache));
 
   uint64 ss = img_stream->size();
 
@@ -23,6 +23,7 @@
 #include <mednafen/general.h>
 
 #include <stdio.h>
+#include <algorithm>
 
 #include "CDAccess_CHD.h"
 
@@ -57,12 +58,14 @@ static const int32_t DI_Size_Table[8] =
         2352  // CD-I RAW
 };
 
-CDAccess_CHD::CDAccess_CHD(VirtualFS* vfs, const std::string &path, bool image_memcache) : NumTracks(0), total_sectors(0)
+CDAccess_CHD::CDAccess_CHD(VirtualFS* vfs, const std::string &path, bool image_memcache, const CDAccessOptions& opts) : NumTracks(0), total_sectors(0)
 {
-  Load(vfs, path, image_memcache);
+  Load(vfs, path, image_memcache, opts);
+  if (prefetchHunks)
+    prefetchThread = std::thread([this]{ PrefetchThread(); });
 }
 
-void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memcache)
+void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memcache, const CDAccessOptions& opts)
 {
 	// Note: chd_open_file() should set chd->owns_file to true
   chd_error err = chd_open_file(vfs->openAsStdio(path, VirtualFS::MODE_READ), CHD_OPEN_READ, NULL, &chd);
@@ -81,10 +84,14 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
     }
   }
 
+  /* no read-ahead when chd_precache() already loaded the whole image */
+  prefetchHunks = image_memcache ? 0 : opts.chdPrefetchHunks;
+
   /* allocate storage for sector reads */
   const chd_header *head = chd_get_header(chd);
-  hunkmem = (uint8_t *)malloc(head->hunkbytes);
-  oldhunk = -1;
+  hunkCache.resize(std::max(opts.chdHunkCacheSize, prefetchHunks + 1));
+  for (auto &h : hunkCache)
+    h.data = std::make_unique<uint8_t[]>(head->hunkbytes);
 
   MDFN_printf("chd_load '%s' hunkbytes=%d\n", path.c_str(), head->hunkbytes);
 
@@ -213,38 +220,47 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
 
 CDAccess_CHD::~CDAccess_CHD()
 {
+  if (prefetchThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(hunkMutex);
+      prefetchQuit = true;
+    }
+    prefetchCond.notify_one();
+    prefetchThread.join();
+  }
+
   if (chd != NULL)
     chd_close(chd);
-
-  if (hunkmem)
-    free(hunkmem);
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+CDAccess_CHD::CachedHunk* CDAccess_CHD::FindHunk(int hunknum)
 {
-  const chd_header *head = chd_get_header(chd);
-  int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
-
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  for (auto &h : hunkCache)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    if (h.hunknum == hunknum)
+      return &h;
   }
+  return nullptr;
+}
 
-  memcpy(buf, hunkmem + hunkofs * (2352 + 96), 2352);
-
-  return err;
+// Decompresses a hunk into the least recently used slot, chdMutex must be held and lock must own hunkMutex.
+// hunkMutex is released while decoding so cache hits aren't blocked, the slot can't be found until it's filled.
+CDAccess_CHD::CachedHunk* CDAccess_CHD::LoadHunk(int hunknum, std::unique_lock<std::mutex>& lock, int& err)
+{
+  auto &h = *std::min_element(hunkCache.begin(), hunkCache.end(),
+    [](const CachedHunk &a, const CachedHunk &b){ return a.lastUse < b.lastUse; });
+  h.hunknum = -1;
+  lock.unlock();
+  err = chd_read(chd, hunknum, h.data.get());
+  lock.lock();
+  if (err != CHDERR_NONE)
+    return nullptr;
+  h.hunknum = hunknum;
+  return &h;
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+int CDAccess_CHD::Read_CHD_Hunk_Data(uint8_t *buf, size_t size, int32_t lba, CHDFILE_TRACK_INFO* track)
 {
   const chd_header *head = chd_get_header(chd);
   int cad = lba - track->LBA + track->fileOffset;
@@ -253,43 +269,98 @@ bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INF
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
   int err = CHDERR_NONE;
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  std::unique_lock<std::mutex> lock(hunkMutex);
+  /* each hunk holds ~8 sectors, check the cache before decompressing */
+  auto h = FindHunk(hunknum);
+  if (!h)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    /* wait for any hunk the prefetch thread is decoding, it may be this one */
+    lock.unlock();
+    std::unique_lock<std::mutex> decodeLock(chdMutex);
+    lock.lock();
+    if (!(h = FindHunk(hunknum)))
+      h = LoadHunk(hunknum, lock, err);
+    decodeLock.unlock();
+    if (!h)
+    {
+      MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
+      return err;
+    }
   }
+  h->lastUse = ++hunkUseCount;
+  memcpy(buf, h->data.get() + hunkofs * (2352 + 96), size);
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2048);
+  /* queue read-ahead when moving to a new hunk */
+  if (hunknum != lastHunk)
+  {
+    if (hunknum == lastHunk - 1)
+      readDirection = -1;
+    else if (hunknum == lastHunk + 1)
+      readDirection = 1;
+    lastHunk = hunknum;
+    if (prefetchThread.joinable())
+    {
+      prefetchStart = hunknum + readDirection;
+      lock.unlock();
+      prefetchCond.notify_one();
+    }
+  }
 
   return err;
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+void CDAccess_CHD::PrefetchThread(void)
 {
   const chd_header *head = chd_get_header(chd);
-  int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
-
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  const int totalHunks = head->totalhunks;
+  std::unique_lock<std::mutex> lock(hunkMutex);
+  while (1)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    prefetchCond.wait(lock, [&]{ return prefetchQuit || prefetchStart != -1; });
+    if (prefetchQuit)
+      return;
+    int start = prefetchStart;
+    int direction = readDirection;
+    prefetchStart = -1;
+    for (unsigned i = 0; i < prefetchHunks; i++)
+    {
+      int hunknum = start + (int)i * direction;
+      if (hunknum < 0 || hunknum >= totalHunks)
+        break;
+      if (FindHunk(hunknum))
+        continue;
+      lock.unlock();
+      std::lock_guard<std::mutex> decodeLock(chdMutex);
+      lock.lock();
+      /* a new request or exit supersedes this one */
+      if (prefetchQuit || prefetchStart != -1)
+        break;
+      if (!FindHunk(hunknum))
+      {
+        int err;
+        auto h = LoadHunk(hunknum, lock, err);
+        if (!h)
+          break;
+        /* rank just below the hunk being read so it's kept until used */
+        h->lastUse = hunkUseCount;
+      }
+    }
   }
+}
+
+bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk_Data(buf, 2352, lba, track);
+}
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2336);
+bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk_Data(buf + 16, 2048, lba, track);
+}
 
-  return err;
+bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk_Data(buf + 16, 2336, lba, track);
 }
 
 int CDAccess_CHD::Read_Raw_Sector(uint8 *buf, int32 lba)
@@ -24,6 +24,11 @@
 
 #include "CDAccess.h"
 #include <libchdr/chd.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace Mednafen
 {
@@ -57,7 +62,7 @@ class CDAccess_CHD final : public CDAccess
 {
  public:
 
- CDAccess_CHD(VirtualFS* vfs, const std::string& path, bool image_memcache);
+ CDAccess_CHD(VirtualFS* vfs, const std::string& path, bool image_memcache, const CDAccessOptions& opts = {});
  ~CDAccess_CHD() final;
 
  int Read_Raw_Sector(uint8 *buf, int32 lba) final;
@@ -68,11 +73,12 @@ class CDAccess_CHD final : public CDAccess
 
  void HintReadSector(int32 lba, int32 count) final {};
 
+
  int Read_Sector(uint8 *buf, int32 lba, uint32 size) final;
 
  private:
 
- void Load(VirtualFS* vfs, const std::string& path, bool image_memcache);
+ void Load(VirtualFS* vfs, const std::string& path, bool image_memcache, const CDAccessOptions& opts);
  void Cleanup(void);
 
   // MakeSubPQ will OR the simulated P and Q subchannel data into SubPWBuf.
@@ -81,6 +87,18 @@ class CDAccess_CHD final : public CDAccess
   bool Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
   bool Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
   bool Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
+  int Read_CHD_Hunk_Data(uint8_t *buf, size_t size, int32_t lba, CHDFILE_TRACK_INFO* track);
+
+  struct CachedHunk
+  {
+   std::unique_ptr<uint8_t[]> data;
+   int hunknum = -1;
+   uint64_t lastUse = 0;
+  };
+
+  CachedHunk* FindHunk(int hunknum);
+  CachedHunk* LoadHunk(int hunknum, std::unique_lock<std::mutex>& lock, int& err);
+  void PrefetchThread(void);
 
   int32_t NumTracks;
   int32_t FirstTrack;
@@ -96,11 +114,20 @@ class CDAccess_CHD final : public CDAccess
   //struct track tracks[DISC_MAX_TRACKS];
   int num_tracks;
 
-  chd_file *chd;
-  /* hunk data cache */
-  uint8_t *hunkmem;
-  /* last hunknum read */
-  int oldhunk;
+  chd_file *chd = nullptr;
+  /* decompressed hunk LRU cache guarded by hunkMutex, chd access and decoding by chdMutex */
+  std::vector<CachedHunk> hunkCache;
+  uint64_t hunkUseCount = 0;
+  std::mutex hunkMutex;
+  std::mutex chdMutex;
+  /* read-ahead state */
+  std::thread prefetchThread;
+  std::condition_variable prefetchCond;
+  int lastHunk = -1;
+  int readDirection = 1;
+  int prefetchStart = -1;
+  unsigned prefetchHunks = 0;
+  bool prefetchQuit = false;
 };
 
 }
@@ -212,13 +212,7 @@ void CDAccess_Image::ParseTOCFileLineInfo(VirtualFS* vfs, CDRFILE_TRACK_INFO *tr
 
   efn = vfs->eval_fip(base_dir, filename);
 
-  if(image_memcache)
-   track->fp = new MemoryStream(vfs->open(efn, VirtualFS::MODE_READ));
-  else
-  {
-   track->fp = vfs->open(efn, VirtualFS::MODE_READ);
-   track->fp->require_fast_seekable();
-  }
+  track->fp = CDAccess_OpenImageStream(vfs, efn, image_memcache);
 
   toc_streamcache[filename] = track->fp;
  }
@@ -647,14 +641,9 @@ void CDAccess_Image::ImageOpen(VirtualFS* vfs, const std::string& path, bool ima
      }
 
      std::string efn = vfs->eval_fip(base_dir, args[0]);
-     TmpTrack.fp = vfs->open(efn, VirtualFS::MODE_READ);
+     TmpTrack.fp = CDAccess_OpenImageStream(vfs, efn, image_memcache);
      TmpTrack.FirstFileInstance = 1;
 
-     if(image_memcache)
-      TmpTrack.fp = new MemoryStream(TmpTrack.fp);
-     else
-      TmpTrack.fp->require_fast_seekable();
-
      if(!MDFN_strazicmp(args[1].c_str(), "BINARY"))
      {
       //TmpTrack.Format = TRACK_FORMAT_DATA;
@@ -25,6 +25,7 @@
 #include <mednafen/types.h>
 #include <mednafen/Stream.h>
 #include <mednafen/cdrom/CDUtility.h>
+#include <mednafen/cdrom/CDAccess.h>
 
 namespace Mednafen
 {
@@ -41,7 +42,7 @@ class CDInterface
  // the CDInterface object is deleted.  If "image_memcache" is true, then the VirtualFS object
  // only needs to remain valid until Open() returns.
  //
- static CDInterface* Open(VirtualFS* vfs, const std::string& path, bool image_memcache, const uint64 affinity);
+ static CDInterface* Open(VirtualFS* vfs, const std::string& path, bool image_memcache, const uint64 affinity, const CDAccessOptions& opts = {});
 
  CDInterface();
  virtual ~CDInterface();
@@ -115,6 +115,13 @@ void CDInterface_MT::CDInterface_Queue::Write(const CDInterface_Message &message
  MThreading::Mutex_Unlock(ze_mutex);
 }
 
+void CDInterface_MT::WriteReadThreadQueue(unsigned int message, int32 lba)
+{
+ // Blocks only if the read thread falls a full queue behind
+ ReadThreadQueue.push({message, lba}, {.blocking = true});
+ ReadThreadQueue.notifyWrite();
+}
+
 static int ReadThreadStart_C(void* arg)
 {
  return ((CDInterface_MT*)arg)->ReadThreadStart();
@@ -154,13 +161,14 @@ int CDInterface_MT::ReadThreadStart()
 
  while(Running)
  {
-  CDInterface_Message msg;
+  CDInterface_Command msg;
 
   //printf("%d %d %d\n", last_read_lba, ra_lba, ra_count);
 
   // Only do a blocking-wait for a message if we don't have any sectors to read-ahead.
-  if(ReadThreadQueue.Read(&msg, ra_count ? false : true))
+  if(ReadThreadQueue.read({&msg, 1}, {.blocking = !ra_count}))
   {
+   ReadThreadQueue.notifyRead();
    if(msg.message == CDInterface_MSG_DIEDIEDIE)
     Running = false;
    else if(msg.message == CDInterface_MSG_READ_SECTOR)
@@ -169,7 +177,7 @@ int CDInterface_MT::ReadThreadStart()
     static const int initial_ra = 1;
     static const int speedmult_ra = 2;
     //
-    const int32 new_lba = msg.args[0];
+    const int32 new_lba = msg.lba;
 
     static_assert((unsigned int)max_ra < (SBSize / 4), "Max readahead too large.");
 
@@ -208,6 +216,7 @@ int CDInterface_MT::ReadThreadStart()
 
    try
    {
+    disc_cdaccess->HintSequentialRead(ra_lba);
     disc_cdaccess->Read_Raw_Sector(tmpbuf, ra_lba);
    }
    catch(std::exception &e)
@@ -247,7 +256,7 @@ void CDInterface_MT::Cleanup(void)
 
  if(CDReadThread)
  {
-  ReadThreadQueue.Write(CDInterface_Message(CDInterface_MSG_DIEDIEDIE));
+  WriteReadThreadQueue(CDInterface_MSG_DIEDIEDIE);
  }
 
  if(!thread_deaded_failed)
@@ -323,7 +332,7 @@ bool CDInterface_MT::ReadRawSector(uint8 *buf, int32 lba)
  }
  //fprintf(stderr, "%d\n", ra_lba - lba);
 
- ReadThreadQueue.Write(CDInterface_Message(CDInterface_MSG_READ_SECTOR, lba));
+ WriteReadThreadQueue(CDInterface_MSG_READ_SECTOR, lba);
 
  //
  //
@@ -375,7 +384,7 @@ bool CDInterface_MT::ReadRawSectorPWOnly(uint8* pwbuf, int32 lba, bool hint_full
  if(disc_cdaccess->Fast_Read_Raw_PW_TSRE(pwbuf, lba))
  {
   if(hint_fullread)
-   ReadThreadQueue.Write(CDInterface_Message(CDInterface_MSG_READ_SECTOR, lba));
+   WriteReadThreadQueue(CDInterface_MSG_READ_SECTOR, lba);
 
   return true;
  }
@@ -396,7 +405,7 @@ void CDInterface_MT::HintReadSector(int32 lba)
  if(UnrecoverableError)
   return;
 
- ReadThreadQueue.Write(CDInterface_Message(CDInterface_MSG_READ_SECTOR, lba));
+ WriteReadThreadQueue(CDInterface_MSG_READ_SECTOR, lba);
 }
 
 }
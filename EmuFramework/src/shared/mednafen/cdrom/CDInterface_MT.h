@@ -25,6 +25,7 @@
 #include <mednafen/cdrom/CDInterface.h>
 #include <mednafen/cdrom/CDAccess.h>
 #include <mednafen/MThreading.h>
+#include <imagine/util/container/RingBuffer.hh>
 #include <queue>
 
 namespace Mednafen
@@ -102,8 +103,16 @@ class CDInterface_MT : public CDInterface
   MThreading::Cond *ze_cond;
  };
 
- // Queue for messages to the read thread.
- CDInterface_Queue ReadThreadQueue;
+ struct CDInterface_Command
+ {
+  unsigned int message;
+  int32 lba;
+ };
+
+ // Queue for commands to the read thread, written only by the emu thread.
+ IG::RingBuffer<CDInterface_Command, {.fixedSize = 256}> ReadThreadQueue;
+
+ void WriteReadThreadQueue(unsigned int message, int32 lba = 0);
 
  // Queue for messages to the emu thread.
  CDInterface_Queue EmuThreadQueue;
@@ -50,7 +50,7 @@ CDInterface_ST::~CDInterface_ST()
 
 void CDInterface_ST::HintReadSector(int32 lba)
 {
- disc_cdaccess->HintReadSector(lba, 1);
+ disc_cdaccess->HintSequentialRead(lba);
 }
 
 bool CDInterface_ST::ReadRawSector(uint8 *buf, int32 lba)
@@ -70,6 +70,7 @@ bool CDInterface_ST::ReadRawSector(uint8 *buf, int32 lba)
 
  try
  {
+  disc_cdaccess->HintSequentialRead(lba);
   disc_cdaccess->Read_Raw_Sector(buf, lba);
  }
  catch(std::exception &e)
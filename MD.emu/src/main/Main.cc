@@ -361,7 +361,7 @@ void MdSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate
 				}
 				io = std::move(*archIt);
 			}
-			ArchiveVFS archVFS{ArchiveIO{std::move(io)}};
+			ArchiveVFS archVFS{ArchiveIO{std::move(io)}, EmuApp::get(appContext()).archiveCache, contentLocation()};
 			cd = CDAccess_Open(&archVFS, std::string{contentFileName()}, true);
 		}
 		else
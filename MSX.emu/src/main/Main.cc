@@ -65,6 +65,7 @@ bool EmuSystem::handlesGenericIO = false; // TODO: need to re-factor BlueMSX fil
 bool EmuSystem::hasResetModes = true;
 bool EmuSystem::canRenderRGBA8888 = false;
 bool EmuSystem::hasRectangularPixels = true;
+bool EmuSystem::skipsUnchangedVideoRows = true;
 bool EmuApp::needsGlobalInstance = true;
 BoardInfo boardInfo{};
 Mixer *mixer{};
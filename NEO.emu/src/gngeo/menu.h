@@ -25,6 +25,11 @@ enum { PBAR_ACTION_LOADROM, PBAR_ACTION_DECRYPT, PBAR_ACTION_LOADGNO, PBAR_ACTIO
 void gn_init_pbar(unsigned action,int size);
 void gn_update_pbar(int pos);
 void gn_terminate_pbar(void);
+int gn_load_canceled(void);
+
+typedef struct GN_TASK GN_TASK;
+GN_TASK *gn_start_task(void (*func)(void *arg), void *arg);
+void gn_join_task(GN_TASK *task);
 
 void gn_popup_error(char *name,char *fmt,...);
 int gn_popup_question(char *name,char *fmt,...);
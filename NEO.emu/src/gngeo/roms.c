@@ -1102,15 +1102,58 @@ static int convert_roms_tile(Uint8 *g, int tileno) {
 
 }
 
-void convert_all_tile(GAME_ROMS *r) {
+/* Tile conversion is split into jobs that can run while the BIOS is still
+   being read. Job ranges are multiples of 16 tiles so each spr_usage word
+   is only written by one job. */
+#define CONVERT_TILE_JOBS 4
+
+typedef struct CONVERT_TILE_JOB {
+	GAME_ROMS *r;
+	Uint32 start, end;
+	GN_TASK *task;
+} CONVERT_TILE_JOB;
+
+static void convert_tile_range(void *arg) {
+	CONVERT_TILE_JOB *job = arg;
 	Uint32 i;
+	for (i = job->start; i < job->end; i++) {
+		((Uint32*) job->r->spr_usage.p)[i >> 4] |= convert_roms_tile(job->r->tiles.p, i);
+	}
+}
+
+static void start_convert_all_tile(GAME_ROMS *r, CONVERT_TILE_JOB jobs[CONVERT_TILE_JOBS]) {
+	Uint32 tiles = r->tiles.size >> 7;
+	Uint32 jobTiles = (((tiles + CONVERT_TILE_JOBS - 1) / CONVERT_TILE_JOBS) + 15) & ~15;
+	int j;
 	allocate_region(&r->spr_usage, (r->tiles.size >> 11) * sizeof (Uint32), REGION_SPR_USAGE);
 	memset(r->spr_usage.p, 0, r->spr_usage.size);
-	for (i = 0; i < r->tiles.size >> 7; i++) {
-		((Uint32*) r->spr_usage.p)[i >> 4] |= convert_roms_tile(r->tiles.p, i);
+	for (j = 0; j < CONVERT_TILE_JOBS; j++) {
+		jobs[j].r = r;
+		jobs[j].start = jobTiles * j < tiles ? jobTiles * j : tiles;
+		jobs[j].end = jobTiles * (j + 1) < tiles ? jobTiles * (j + 1) : tiles;
+		jobs[j].task = NULL;
+		if (jobs[j].start == jobs[j].end)
+			continue;
+		jobs[j].task = gn_start_task(convert_tile_range, &jobs[j]);
+		if (!jobs[j].task)
+			convert_tile_range(&jobs[j]);
+	}
+}
+
+static void finish_convert_all_tile(CONVERT_TILE_JOB jobs[CONVERT_TILE_JOBS]) {
+	int j;
+	for (j = 0; j < CONVERT_TILE_JOBS; j++) {
+		if (jobs[j].task)
+			gn_join_task(jobs[j].task);
 	}
 }
 
+void convert_all_tile(GAME_ROMS *r) {
+	CONVERT_TILE_JOB jobs[CONVERT_TILE_JOBS];
+	start_convert_all_tile(r, jobs);
+	finish_convert_all_tile(jobs);
+}
+
 void convert_all_char(Uint8 *Ptr, int Taille,
 		Uint8 *usage_ptr) {
 	int i, j;
@@ -1429,6 +1472,10 @@ int dr_load_roms(void *contextPtr, GAME_ROMS *r, char *rom_path, char *name, cha
 		romsize += drv->rom[i].size;
 	gn_init_pbar(PBAR_ACTION_LOADROM, romsize);
 	for (i = 0; i < (int)drv->nb_romfile; i++) {
+		if (gn_load_canceled()) {
+			sprintf(romerror, "Loading canceled");
+			goto error1;
+		}
 		if(drv->rom[i].region == REGION_FIXED_LAYER_BIOS)
 		{
 			logMsg("skipping BIOS SFIX defined in driver");
@@ -1480,10 +1527,13 @@ int dr_load_roms(void *contextPtr, GAME_ROMS *r, char *rom_path, char *name, cha
 	 */
 	memory.nb_of_tiles = r->tiles.size >> 7;
 
-	/* Init rom and bios */
+	/* Init rom and bios, converting the sprite tiles while the BIOS loads */
 	init_roms(contextPtr, r);
-	convert_all_tile(r);
-	return dr_load_bios(contextPtr, r, romerror);
+	CONVERT_TILE_JOB jobs[CONVERT_TILE_JOBS];
+	start_convert_all_tile(r, jobs);
+	bool biosLoaded = dr_load_bios(contextPtr, r, romerror);
+	finish_convert_all_tile(jobs);
+	return biosLoaded;
 
 error1:
 	gn_terminate_pbar();
@@ -1799,6 +1849,11 @@ int dr_open_gno(void *contextPtr, char *filename, char romerror[1024]) {
 	gn_init_pbar(PBAR_ACTION_LOADGNO, nb_sec);
 	for (i = 0; i < nb_sec; i++) {
 		gn_update_pbar(i);
+		if (gn_load_canceled()) {
+			fclose(gno);
+			sprintf(romerror, "Loading canceled");
+			return false;
+		}
 		read_region(gno, r);
 	}
 	gn_terminate_pbar();
@@ -23,6 +23,7 @@
 #include <imagine/util/format.hh>
 #include <imagine/util/zlib.hh>
 #include <imagine/logger/logger.h>
+#include <thread>
 
 extern "C"
 {
@@ -279,6 +280,7 @@ void NeoSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate
 		throwMissingContentDirError();
 	}
 	onLoadProgress = onLoadProgressFunc;
+	loadCanceled = false;
 	auto resetOnLoadProgress = IG::scopeGuard([&](){ onLoadProgress = {}; });
 	auto ctx = appContext();
 	ROM_DEF *drv = res_load_drv(&ctx, contentName().data());
@@ -306,7 +308,7 @@ void NeoSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate
 			throw std::runtime_error(errorStr);
 		}
 
-		if(optionCreateAndUseCache && !ctx.fileUriExists(gnoFilename))
+		if(optionCreateAndUseCache && !loadCanceled && !ctx.fileUriExists(gnoFilename))
 		{
 			log.info("{} doesn't exist, creating", gnoFilename);
 			dr_save_gno(&memory.rom, gnoFilename.data());
@@ -493,7 +495,8 @@ void gn_init_pbar(unsigned action, int size)
 				case PBAR_ACTION_SAVEGNO: { return "Building Cache...\n(may take a while)"; };
 			}
 		};
-		sys.onLoadProgress(0, size, actionString(action));
+		if(!sys.onLoadProgress(0, size, actionString(action)))
+			sys.loadCanceled = true;
 	}
 }
 
@@ -503,6 +506,36 @@ void gn_update_pbar(int pos)
 	logMsg("update pbar %d", pos);
 	if(sys.onLoadProgress)
 	{
-		sys.onLoadProgress(pos, 0, nullptr);
+		if(!sys.onLoadProgress(pos, 0, nullptr))
+			sys.loadCanceled = true;
 	}
 }
+
+int gn_load_canceled()
+{
+	return static_cast<NeoSystem&>(gSystem()).loadCanceled;
+}
+
+struct GN_TASK
+{
+	std::thread thread;
+};
+
+GN_TASK *gn_start_task(void (*func)(void *arg), void *arg)
+{
+	try
+	{
+		return new GN_TASK{std::thread{func, arg}};
+	}
+	catch(std::system_error &err)
+	{
+		logWarn("can't start task thread:%s", err.what());
+		return nullptr;
+	}
+}
+
+void gn_join_task(GN_TASK *task)
+{
+	task->thread.join();
+	delete task;
+}
@@ -62,6 +62,7 @@ public:
 	uint16_t screenBuff[FBResX*256] __attribute__ ((aligned (8))){};
 	FS::PathString datafilePath{};
 	EmuSystem::OnLoadProgressDelegate onLoadProgress{};
+	bool loadCanceled{};
 	Property<bool, CFGKEY_LIST_ALL_GAMES> optionListAllGames;
 	Property<uint8_t, CFGKEY_BIOS_TYPE,
 		PropertyDesc<uint8_t>{.defaultValue = SYS_UNIBIOS, .isValid = systemEnumIsValid}> optionBIOSType;
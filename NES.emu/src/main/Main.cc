@@ -381,6 +381,7 @@ void NesSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 bool NesSystem::onVideoRenderFormatChange(EmuVideo &video, PixelFormat fmt)
 {
 	pixFmt = fmt;
+	nativeCol.setFormat(fmt);
 	updateVideoPixmap(video, optionHorizontalVideoCrop, optionVisibleVideoLines);
 	FCEU_ResetPalette();
 	return true;
@@ -419,23 +420,10 @@ void NesSystem::updateVideoPixmap(EmuVideo &video, bool horizontalCrop, int line
 
 void NesSystem::renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, uint8 *buf)
 {
-	auto img = video.startFrame(taskCtx);
-	auto pix = img.pixmap();
 	PixmapView ppuPix{{{256, 256}, PixelFmtI8}, buf};
-	int xStart = pix.w() == 256 ? 0 : 8;
+	int xStart = video.size().x == 256 ? 0 : 8;
 	int yStart = optionStartVideoLine;
-	auto ppuPixRegion = ppuPix.subView({xStart, yStart}, pix.size());
-	assumeExpr(pix.size() == ppuPixRegion.size());
-	if(pix.format() == PixelFmtRGB565)
-	{
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col16[p]; }, ppuPixRegion);
-	}
-	else
-	{
-		assumeExpr(pix.format().bytesPerPixel() == 4);
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col32[p]; }, ppuPixRegion);
-	}
-	img.endFrame();
+	video.startIndexedFrame(taskCtx, ppuPix.subView({xStart, yStart}, video.size()), nativeCol);
 }
 
 void NesSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
@@ -472,15 +460,7 @@ void FCEUD_SetPalette(uint8 index, uint8 r, uint8 g, uint8 b)
 {
 	using namespace EmuEx;
 	auto &sys = static_cast<NesSystem&>(gSystem());
-	if(sys.pixFmt == PixelFmtRGB565)
-	{
-		sys.nativeCol.col16[index] = sys.pixFmt.desc().build(r >> 3, g >> 2, b >> 3, 0);
-	}
-	else // RGBA8888
-	{
-		auto desc = sys.pixFmt == PixelFmtBGRA8888 ? PixelDescBGRA8888Native : PixelDescRGBA8888Native;
-		sys.nativeCol.col32[index] = desc.build(r, g, b, (uint8)0);
-	}
+	sys.nativeCol.setColor(index, r, g, b);
 	//log.debug("set palette {} {}", index, nativeCol[index]);
 }
 
@@ -17,6 +17,7 @@
 
 #include <emuframework/EmuOptions.hh>
 #include <emuframework/EmuSystem.hh>
+#include <emuframework/IndexedPalette.hh>
 #include <fceu/driver.h>
 #include <fceu/palette.h>
 #include <fceu/state.h>
@@ -95,11 +96,7 @@ public:
 	uint8_t autoDetectedRegion{};
 	PixelFormat pixFmt{};
 	PalArray defaultPal{};
-	union
-	{
-		uint16_t col16[256];
-		uint32_t col32[256];
-	} nativeCol;
+	IndexedPalette nativeCol;
 	alignas(16) uint8 XBufData[256 * 256 + 16]{};
 	std::string cheatsDir;
 	std::string patchesDir;
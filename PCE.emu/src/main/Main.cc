@@ -129,7 +129,7 @@ void PceSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 		auto unloadCD = scopeGuard([&]() { clearCDInterfaces(CDInterfaces); });
 		if(isArchive)
 		{
-			ArchiveVFS archVFS{ArchiveIO{std::move(io)}};
+			ArchiveVFS archVFS{ArchiveIO{std::move(io)}, EmuApp::get(appContext()).archiveCache, contentLocation()};
 			CDInterfaces.push_back(CDInterface::Open(&archVFS, std::string{contentFileName()}, true, 0));
 		}
 		else
@@ -624,6 +624,45 @@ class CustomVideoOptionView : public VideoOptionView, public MainAppHelper
 		}
 	};
 
+	TextMenuItem vdp2ThreadsItem[5]
+	{
+		{"Auto", attachParams(), {.id = 0}},
+		{"1", attachParams(), {.id = 1}},
+		{"2", attachParams(), {.id = 2}},
+		{"4", attachParams(), {.id = 4}},
+		{"8", attachParams(), {.id = 8}},
+	};
+
+	MultiChoiceMenuItem vdp2Threads
+	{
+		"VDP2 Render Threads", attachParams(),
+		MenuId{system().vdp2Threads},
+		vdp2ThreadsItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item, const Input::Event &e)
+			{
+				system().vdp2Threads = item.id.val;
+				app().promptSystemReloadDueToSetOption(attachParams(), e);
+			}
+		}
+	};
+
+	BoolMenuItem vdp1Thread
+	{
+		"Threaded VDP1 Drawing", attachParams(),
+		system().vdp1Thread,
+		[this](BoolMenuItem &item, View &, Input::Event e)
+		{
+			system().vdp1Thread = item.flipBoolValue(*this);
+			if(system().vdp1Thread && !system().canUseVDP1Thread(app()))
+			{
+				app().postMessage(4, false, "Threaded VDP1 Drawing stays off while Run-ahead or Rewind is enabled");
+				return;
+			}
+			app().promptSystemReloadDueToSetOption(attachParams(), e);
+		}
+	};
+
 public:
 	CustomVideoOptionView(ViewAttachParams attach, EmuVideoLayer &layer): VideoOptionView{attach, layer, true}
 	{
@@ -632,6 +671,8 @@ public:
 		item.emplace_back(&showHOverscan);
 		item.emplace_back(&visibleVideoLines);
 		item.emplace_back(&correctLineAspect);
+		item.emplace_back(&vdp2Threads);
+		item.emplace_back(&vdp1Thread);
 	}
 };
 
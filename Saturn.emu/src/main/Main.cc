@@ -273,7 +273,7 @@ void SaturnSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDele
 		{
 			filenames.emplace_back(cdImgFile.name());
 		}
-		ArchiveVFS archVFS{std::move(cdImgFile)};
+		ArchiveVFS archVFS{std::move(cdImgFile), EmuApp::get(appContext()).archiveCache, contentLocation()};
 		for(auto &fn : filenames)
 		{
 			CDInterfaces.emplace_back(CDInterface::Open(&archVFS, std::move(fn), true, 0));
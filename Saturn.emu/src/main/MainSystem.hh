@@ -21,6 +21,7 @@
 #include <ss/ss.h>
 #include <ss/smpc.h>
 #include <ss/cart.h>
+#include <ss/vdp2_render.h>
 
 extern const Mednafen::MDFNGI EmulatedSS;
 
@@ -37,6 +38,11 @@ extern const int ActiveCartType;
 extern uint8 AreaCode;
 }
 
+namespace MDFN_IEN_SS::VDP1
+{
+extern IG::ThreadId DThreadId;
+}
+
 namespace MDFN_IEN_SS::VDP2
 {
 extern const uint8 InterlaceMode;
@@ -85,7 +91,8 @@ enum
 	CFGKEY_DEFAULT_NTSC_VIDEO_LINES = 287, CFGKEY_DEFAULT_PAL_VIDEO_LINES = 288,
 	CFGKEY_DEFAULT_SHOW_H_OVERSCAN = 289, CFGKEY_SHOW_H_OVERSCAN = 290,
 	CFGKEY_DEINTERLACE_MODE = 291, CFGKEY_WIDESCREEN_MODE = 292,
-	CFGKEY_NO_MD5_FILENAMES = 293
+	CFGKEY_NO_MD5_FILENAMES = 293, CFGKEY_VDP2_THREADS = 294,
+	CFGKEY_VDP1_THREAD = 295
 };
 
 struct VideoLineRange
@@ -125,6 +132,7 @@ public:
 	uint8_t lastInterlaceMode{};
 	int8_t region{};
 	int8_t biosLanguage{MDFN_IEN_SS::SMPC_RTC_LANG_ENGLISH};
+	uint8_t vdp2Threads{};
 	InputConfig inputConfig{};
 	DeinterlaceMode deinterlaceMode{DeinterlaceMode::Bob};
 	bool defaultShowHOverscan{};
@@ -132,6 +140,7 @@ public:
 	bool correctLineAspect{};
 	bool autoRTCTime{true};
 	bool noMD5InFilenames{};
+	bool vdp1Thread{};
 	Rotation sysContentRotation{Rotation::ANY};
 	WidescreenMode widescreenMode{WidescreenMode::Auto};
 
@@ -160,6 +169,8 @@ public:
 		showHOverscan = on;
 		updateVideoSettings();
 	}
+	bool canUseVDP1Thread(const EmuApp &) const;
+	bool onRunAheadOrRewindChanged(EmuApp &);
 
 	// required API functions
 	void loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate);
@@ -194,7 +205,16 @@ public:
 	bool onPointerInputStart(const Input::MotionEvent &e, Input::DragTrackerState, WRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, WRect);
 	Rotation contentRotation() const;
-	void addThreadGroupIds(std::vector<ThreadId> &ids) const { ids.emplace_back(MDFN_IEN_SS::RThreadId); }
+	void addThreadGroupIds(std::vector<ThreadId> &ids) const
+	{
+		ids.emplace_back(MDFN_IEN_SS::RThreadId);
+		if(MDFN_IEN_SS::VDP1::DThreadId)
+			ids.emplace_back(MDFN_IEN_SS::VDP1::DThreadId);
+		for(auto id : MDFN_IEN_SS::VDP2REND_GetBandThreadIds())
+		{
+			ids.emplace_back(id);
+		}
+	}
 };
 
 using MainSystem = SaturnSystem;
@@ -20,6 +20,7 @@
 #include <mednafen-emuex/MDFNUtils.hh>
 #include <mednafen/general.h>
 #include <ss/smpc.h>
+#include <ss/vdp1.h>
 #include <ss/db.h>
 
 namespace EmuEx
@@ -80,6 +81,8 @@ bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_DEFAULT_PAL_VIDEO_LINES: return readOptionValue(io, defaultPalLines, linesAreValid<288>);
 			case CFGKEY_DEFAULT_SHOW_H_OVERSCAN: return readOptionValue(io, defaultShowHOverscan);
 			case CFGKEY_NO_MD5_FILENAMES: return readOptionValue(io, noMD5InFilenames);
+			case CFGKEY_VDP2_THREADS: return readOptionValue(io, vdp2Threads, [](auto v){return v <= MDFN_IEN_SS::VDP2REND_MaxBandThreads + 1;});
+			case CFGKEY_VDP1_THREAD: return readOptionValue(io, vdp1Thread);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -113,6 +116,8 @@ void SaturnSystem::writeConfig(ConfigType type, FileIO &io)
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_PAL_VIDEO_LINES, defaultPalLines, safePalLines);
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_SHOW_H_OVERSCAN, defaultShowHOverscan, false);
 		writeOptionValueIfNotDefault(io, CFGKEY_NO_MD5_FILENAMES, noMD5InFilenames, false);
+		writeOptionValueIfNotDefault(io, CFGKEY_VDP2_THREADS, vdp2Threads, 0);
+		writeOptionValueIfNotDefault(io, CFGKEY_VDP1_THREAD, vdp1Thread, false);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -127,6 +132,19 @@ void SaturnSystem::writeConfig(ConfigType type, FileIO &io)
 	}
 }
 
+bool SaturnSystem::canUseVDP1Thread(const EmuApp &app) const
+{
+	// drawing timing depends on host thread scheduling, so re-running frames
+	// for run-ahead or rewind wouldn't reproduce the same output
+	return vdp1Thread && !app.runAheadFrames && !app.rewindManager.maxStates;
+}
+
+bool SaturnSystem::onRunAheadOrRewindChanged(EmuApp &app)
+{
+	// the drawing thread is only started or stopped when the system loads
+	return hasContent() && MDFN_IEN_SS::VDP1::IsThreaded() != canUseVDP1Thread(app);
+}
+
 Rotation SaturnSystem::contentRotation() const
 {
 	return sysContentRotation == Rotation::ANY ? Rotation::UP : sysContentRotation;
@@ -149,6 +167,8 @@ uint64 MDFN_GetSettingUI(const char *name_)
 		return sys.biosLanguage;
 	if("ss.affinity.vdp2" == name)
 		return 0;
+	if("ss.vdp2.threads" == name)
+		return sys.vdp2Threads;
 	if(name.ends_with("gun_chairs"))
 		return 0xFFFFFFFF;
 	if(name == "ss.dbg_cem")
@@ -205,6 +225,8 @@ bool MDFN_GetSettingB(const char *name_)
 		return sys.showHOverscan;
 	if("ss.h_blend" == name)
 		return false;
+	if("ss.vdp1.thread" == name)
+		return sys.canUseVDP1Thread(EmuApp::get(sys.appContext()));
 	if("ss.region_autodetect" == name)
 		return !sys.region;
 	if("ss.smpc.autortc" == name)
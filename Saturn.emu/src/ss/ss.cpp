@@ -1366,6 +1366,8 @@ static void MDFN_COLD InitCommon(unsigned cpucache_emumode, unsigned horrible_ha
  int sls = MDFN_GetSettingI(PAL ? "ss.slstartp" : "ss.slstart");
  int sle = MDFN_GetSettingI(PAL ? "ss.slendp" : "ss.slend");
  const uint64 vdp2_affinity = MDFN_GetSettingUI("ss.affinity.vdp2");
+ const unsigned vdp2_threads = MDFN_GetSettingUI("ss.vdp2.threads");
+ const bool vdp1_thread = MDFN_GetSettingB("ss.vdp1.thread");
 
  if(PAL)
  {
@@ -1471,8 +1473,8 @@ static void MDFN_COLD InitCommon(unsigned cpucache_emumode, unsigned horrible_ha
  if(cart_type == CART_STV)
   STVIO_Init(sgi);
 
- VDP1::Init();
- VDP2::Init(PAL, vdp2_affinity);
+ VDP1::Init(vdp1_thread);
+ VDP2::Init(PAL, vdp2_affinity, vdp2_threads);
  CDB_Init();
  SOUND_Init(cart_type == CART_STV);
 
@@ -2056,6 +2058,9 @@ INLINE bool EventsPacker::Restore(const unsigned state_version)
 
 static MDFN_COLD void StateAction(StateMem* sm, const unsigned load, const bool data_only)
 {
+ // drawing thread events can raise SCU interrupts, apply them before the SCU state is saved
+ VDP1::Sync();
+
  if(!data_only)
  {
   sha256_digest sr_dig = BIOS_SHA256;
@@ -2456,6 +2461,10 @@ static const MDFNSetting SSSettings[] =
 
  { "ss.affinity.vdp2", MDFNSF_NOFLAGS, gettext_noop("VDP2 rendering thread CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
 
+ { "ss.vdp2.threads", MDFNSF_NOFLAGS, gettext_noop("Number of threads composing VDP2 lines."), gettext_noop("Includes the VDP2 rendering thread.  Set to 0 to pick a count based on the number of CPUs."), MDFNST_UINT, "0", "0", "8" },
+
+ { "ss.vdp1.thread", MDFNSF_NOFLAGS, gettext_noop("Run VDP1 drawing on a separate thread."), gettext_noop("Drawing timing is still accounted for on the emulation thread, but when drawing finishes relative to the emulated CPUs depends on host thread scheduling, so emulation is no longer deterministic."), MDFNST_BOOL, "0" },
+
 #ifdef MDFN_ENABLE_DEV_BUILD
  { "ss.dbg_mask", MDFNSF_SUPPRESS_DOC, gettext_noop("Debug printf mask."), NULL, MDFNST_MULTI_ENUM, "none", NULL, NULL, NULL, NULL, DBGMask_List },
 #endif
@@ -45,6 +45,11 @@
 #include "vdp1.h"
 #include "vdp2.h"
 #include "vdp1_common.h"
+#include <mednafen/MThreading.h>
+#include <imagine/thread/Thread.hh>
+#include <imagine/util/container/RingBuffer.hh>
+
+#include <atomic>
 
 enum : int { VDP1_UpdateTimingGran = 263 };
 enum : int { VDP1_IdleTimingGran = 1019 };
@@ -119,6 +124,54 @@ static uint32 InstantDrawSanityLimit; // ss_horrible_hacks
 uint16 VRAM[0x40000];
 uint16 FB[2][0x20000];
 //
+// Optional drawing thread.  The emulation thread keeps all timing and register state and hands
+// DThreadEntry() the cycles it would have spent drawing, along with any VRAM and framebuffer
+// writes made while drawing may still be in progress, in order.  Drawing state(CycleCounter,
+// CurCommandAddr, EDSR, clip and local coordinates, LineData/PrimData, the draw framebuffer) is
+// only accessed by the emulation thread after Sync().
+//
+static MThreading::Thread* DThread = NULL;
+IG::ThreadId DThreadId{};
+
+enum
+{
+ COMMAND_RUN = 0,
+ COMMAND_SLOWDOWN,
+
+ COMMAND_WRITE8_VRAM,
+ COMMAND_WRITE16_VRAM,
+ COMMAND_WRITE8_FB,
+ COMMAND_WRITE16_FB,
+
+ COMMAND_EXIT
+};
+
+struct WQ_Entry
+{
+ uint16 Command;
+ uint16 Arg16;
+ uint32 Arg32;
+};
+
+static IG::RingBuffer<WQ_Entry, {.fixedSize = 0x4000}> WQ;
+
+static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
+{
+ WQ.push({command, arg16, arg32}, {.blocking = true, .flushSize = 16});
+}
+
+enum : unsigned
+{
+ DTHREAD_EVENT_DRAW_END = 0x1,
+ DTHREAD_EVENT_IRQ = 0x2
+};
+
+static std::atomic<unsigned> DThreadEvents;
+static bool DrawingPending;	// Emulation thread's view of DrawingActive, only set when DThread is running
+static bool WritesQueued;	// VRAM/framebuffer writes were queued since the last Sync()
+
+static int DThreadEntry(void* data);
+//
 //
 //
 #ifdef MDFN_ENABLE_DEV_BUILD
@@ -211,7 +264,7 @@ static INLINE void VRAMUsageEnd(void) { }
 //
 //
 //
-void Init(void)
+void Init(const bool threaded)
 {
  vbcdpending = false;
 
@@ -238,15 +291,37 @@ void Init(void)
  LastRWTS = 0;
 
  VRAMUsageInit();
+
+ WQ.clear();
+ DThreadEvents = 0;
+ DrawingPending = false;
+ WritesQueued = false;
+
+ if(threaded)
+  DThread = MThreading::Thread_Create(DThreadEntry, NULL, "MDFN VDP1 Draw");
 }
 
-void Kill(void)
+bool IsThreaded(void)
 {
+ return DThread != NULL;
+}
 
+void Kill(void)
+{
+ if(DThread != NULL)
+ {
+  WWQ(COMMAND_EXIT);
+  WQ.notifyWrite();
+  MThreading::Thread_Wait(DThread, NULL);
+  DThread = NULL;
+  DThreadId = {};
+ }
 }
 
 void Reset(bool powering_up)
 {
+ Sync();
+
  if(powering_up)
  {
   for(unsigned i = 0; i < 0x40000; i++)
@@ -302,6 +377,7 @@ void Reset(bool powering_up)
  CurCommandAddr = 0;
  RetCommandAddr = -1;
  DrawingActive = false;
+ DrawingPending = false;
  CycleCounter = 0;
  CommandPhase = 0;
  memset(CommandData, 0, sizeof(CommandData));
@@ -744,6 +820,9 @@ static INLINE void DoDrawing(void)
     {
      DrawingActive = false;
      VRAMUsageEnd();
+
+     if(DThread)
+      DThreadEvents.fetch_or(DTHREAD_EVENT_DRAW_END, std::memory_order_release);
      goto Breakout;
     }
     else
@@ -794,8 +873,13 @@ static INLINE void DoDrawing(void)
 
     EDSR |= 0x2;	// TODO: Does EDSR reflect IRQ out status?
 
-    SCU_SetInt(SCU_INT_VDP1, true);
-    SCU_SetInt(SCU_INT_VDP1, false);
+    if(DThread)	// Raised by the emulation thread in ProcessThreadEvents()
+     DThreadEvents.fetch_or(DTHREAD_EVENT_DRAW_END | DTHREAD_EVENT_IRQ, std::memory_order_release);
+    else
+    {
+     SCU_SetInt(SCU_INT_VDP1, true);
+     SCU_SetInt(SCU_INT_VDP1, false);
+    }
     goto Breakout;
    }
 
@@ -837,6 +921,116 @@ static INLINE void DoDrawing(void)
 #endif
 }
 
+static void RunCycles(const int32 cycles, const bool halt_kludge)
+{
+ CycleCounter += cycles;
+ if(CycleCounter > VDP1_UpdateTimingGran)
+  CycleCounter = VDP1_UpdateTimingGran;
+
+ if(CycleCounter > 0 && halt_kludge)
+ {
+  //puts("Kludge");
+  CycleCounter = 0;
+ }
+ else if(DrawingActive)
+  DoDrawing();
+}
+
+static int DThreadEntry(void* data)
+{
+ DThreadId = IG::thisThreadId();
+
+ for(;;)
+ {
+  // The entry is only released after it's processed so Sync() also waits for the drawing it causes
+  auto span = WQ.beginRead(1, {.blocking = true});
+
+  if(span.empty())
+   continue;
+
+  const WQ_Entry* wqe = &span[0];
+
+  if(wqe->Command == COMMAND_EXIT)
+  {
+   WQ.endRead(span);
+   break;
+  }
+
+  switch(wqe->Command)
+  {
+   case COMMAND_RUN:
+	RunCycles((int32)wqe->Arg32, wqe->Arg16);
+	break;
+
+   case COMMAND_SLOWDOWN:
+	if(DrawingActive)
+	 CycleCounter -= wqe->Arg32;
+	break;
+
+   case COMMAND_WRITE8_VRAM:
+	ne16_wbo_be<uint8>(VRAM, wqe->Arg32, wqe->Arg16);
+	break;
+
+   case COMMAND_WRITE16_VRAM:
+	VRAM[wqe->Arg32] = wqe->Arg16;
+	break;
+
+   case COMMAND_WRITE8_FB:
+	ne16_wbo_be<uint8>(FBDrawWhichPtr, wqe->Arg32, wqe->Arg16);
+	break;
+
+   case COMMAND_WRITE16_FB:
+	FBDrawWhichPtr[wqe->Arg32] = wqe->Arg16;
+	break;
+  }
+
+  WQ.endRead(span);
+  WQ.notifyRead();
+ }
+ WQ.notifyRead();
+ return 0;
+}
+
+static void ProcessThreadEvents(void)
+{
+ const unsigned events = DThreadEvents.exchange(0, std::memory_order_acquire);
+
+ if(events & DTHREAD_EVENT_IRQ)
+ {
+  SCU_SetInt(SCU_INT_VDP1, true);
+  SCU_SetInt(SCU_INT_VDP1, false);
+ }
+
+ if(events & DTHREAD_EVENT_DRAW_END)
+  DrawingPending = false;
+}
+
+//
+// Waits for the drawing thread to process everything queued so far, after which the emulation
+// thread may access drawing state directly.
+//
+void Sync(void)
+{
+ if(!DThread)
+  return;
+
+ WQ.waitForSize(0);
+ ProcessThreadEvents();
+ DrawingPending = DrawingActive;
+ WritesQueued = false;
+}
+
+// Writes must be queued while the drawing thread may be reading VRAM or drawing, and until the next
+// Sync() once any are, to stay ordered.
+static INLINE bool QueueWrites(void)
+{
+ if(MDFN_LIKELY(!DrawingPending && !WritesQueued))
+  return false;
+
+ WritesQueued = true;
+ return true;
+}
+
 sscpu_timestamp_t Update(sscpu_timestamp_t timestamp)
 {
  if(MDFN_UNLIKELY(timestamp < lastts))
@@ -853,17 +1047,15 @@ sscpu_timestamp_t Update(sscpu_timestamp_t timestamp)
  int32 cycles = timestamp - lastts;
  lastts = timestamp;
 
- CycleCounter += cycles;
- if(CycleCounter > VDP1_UpdateTimingGran)
-  CycleCounter = VDP1_UpdateTimingGran;
-
- if(CycleCounter > 0 && SCU_CheckVDP1HaltKludge())
+ if(DThread)
  {
-  //puts("Kludge");
-  CycleCounter = 0;
+  WWQ(COMMAND_RUN, cycles, SCU_CheckVDP1HaltKludge());
+  ProcessThreadEvents();
+
+  return timestamp + (DrawingPending ? VDP1_UpdateTimingGran : VDP1_IdleTimingGran);
  }
- else if(DrawingActive)
-  DoDrawing();
+
+ RunCycles(cycles, SCU_CheckVDP1HaltKludge());
 
  return timestamp + (DrawingActive ? std::max<int32>(VDP1_UpdateTimingGran, 0 - CycleCounter) : VDP1_IdleTimingGran);
 }
@@ -886,6 +1078,7 @@ static void StartDrawing(void)
  CurCommandAddr = 0;
  RetCommandAddr = -1;
  DrawingActive = true;
+ DrawingPending = (DThread != NULL);
  CommandPhase = 0;
  VRAMUsageStart();
 
@@ -920,6 +1113,8 @@ void SetHBVB(const sscpu_timestamp_t event_timestamp, const bool new_hb_status,
   }
   else // Leaving v-blank
   {
+   Sync();
+
    InstantDrawSanityLimit = 1000000;
 
    // Run vblank erase at end of vblank all at once(not strictly accurate, but should only have visible side effects wrt the debugger and reset).
@@ -979,6 +1174,7 @@ void SetHBVB(const sscpu_timestamp_t event_timestamp, const bool new_hb_status,
     {
      SS_DBGTI(SS_DBG_WARNING | SS_DBG_VDP1, "[VDP1] Drawing aborted by framebuffer swap.");
      DrawingActive = false;
+     DrawingPending = false;
      VRAMUsageEnd();
     }
 
@@ -1130,6 +1326,8 @@ static INLINE void WriteReg(const unsigned which, const uint16 value)
  SS_SetEventNT(&events[SS_EVENT_VDP2], VDP2::Update(SH7095_mem_timestamp));
  sscpu_timestamp_t nt = Update(SH7095_mem_timestamp);
 
+ Sync();
+
  SS_DBGTI(SS_DBG_VDP1_REGW, "[VDP1] Register write: 0x%02x: 0x%04x", which << 1, value);
 
  switch(which)
@@ -1172,6 +1370,7 @@ static INLINE void WriteReg(const unsigned which, const uint16 value)
 	if(DrawingActive)
 	{
 	 DrawingActive = false;
+	 DrawingPending = false;
          VRAMUsageEnd();
 	 if(CycleCounter < 0)
 	  CycleCounter = 0;
@@ -1215,12 +1414,15 @@ static INLINE uint16 ReadReg(const unsigned which)
 //
 MDFN_FASTCALL void Write_CheckDrawSlowdown(uint32 A, sscpu_timestamp_t time_thing)
 {
- if(DrawingActive && time_thing > LastRWTS && (ss_horrible_hacks & HORRIBLEHACK_VDP1RWDRAWSLOWDOWN))
+ if((DThread ? DrawingPending : DrawingActive) && time_thing > LastRWTS && (ss_horrible_hacks & HORRIBLEHACK_VDP1RWDRAWSLOWDOWN))
  {
   const int32 count = (A & 0x100000) ? 22 : 25;
   const uint32 a = std::min<uint32>(count, time_thing - LastRWTS);
 
-  CycleCounter -= a;
+  if(DThread)
+   WWQ(COMMAND_SLOWDOWN, a);
+  else
+   CycleCounter -= a;
   LastRWTS = time_thing;
  }
 }
@@ -1228,12 +1430,15 @@ MDFN_FASTCALL void Write_CheckDrawSlowdown(uint32 A, sscpu_timestamp_t time_thin
 MDFN_FASTCALL void Read_CheckDrawSlowdown(uint32 A, sscpu_timestamp_t time_thing)
 {
  //printf("%08x\n", A);
- if(!(A & 0x100000) && time_thing > LastRWTS && DrawingActive && (ss_horrible_hacks & HORRIBLEHACK_VDP1RWDRAWSLOWDOWN))
+ if(!(A & 0x100000) && time_thing > LastRWTS && (DThread ? DrawingPending : DrawingActive) && (ss_horrible_hacks & HORRIBLEHACK_VDP1RWDRAWSLOWDOWN))
  {
   const int32 count = (A & 0x80000) ? 44 : 41;
   const uint32 a = std::min<uint32>(count, time_thing - LastRWTS);
 
-  CycleCounter -= a;
+  if(DThread)
+   WWQ(COMMAND_SLOWDOWN, a);
+  else
+   CycleCounter -= a;
   LastRWTS = time_thing;
  }
 }
@@ -1246,7 +1451,10 @@ MDFN_FASTCALL void Write8_DB(uint32 A, uint16 DB)
  {
   VRAMUsageWrite(A >> 1);
   SS_DBGTI(SS_DBG_VDP1_VRAMW, "[VDP1] Write to VRAM: 0x%02x->VRAM[0x%05x]", (DB >> (((A & 1) ^ 1) << 3)) & 0xFF, A);
-  ne16_wbo_be<uint8>(VRAM, A, DB >> (((A & 1) ^ 1) << 3) );
+  if(MDFN_UNLIKELY(QueueWrites()))
+   WWQ(COMMAND_WRITE8_VRAM, A, (DB >> (((A & 1) ^ 1) << 3)) & 0xFF);
+  else
+   ne16_wbo_be<uint8>(VRAM, A, DB >> (((A & 1) ^ 1) << 3) );
   return;
  }
 
@@ -1259,7 +1467,10 @@ MDFN_FASTCALL void Write8_DB(uint32 A, uint16 DB)
   if((TVMR & (TVMR_8BPP | TVMR_ROTATE)) == (TVMR_8BPP | TVMR_ROTATE))
    FBA = (FBA & 0x1FF) | ((FBA << 1) & 0x3FC00) | ((FBA >> 8) & 0x200);
 
-  ne16_wbo_be<uint8>(FB[FBDrawWhich], FBA & 0x3FFFF, DB >> (((A & 1) ^ 1) << 3) );
+  if(MDFN_UNLIKELY(QueueWrites()))
+   WWQ(COMMAND_WRITE8_FB, FBA & 0x3FFFF, (DB >> (((A & 1) ^ 1) << 3)) & 0xFF);
+  else
+   ne16_wbo_be<uint8>(FB[FBDrawWhich], FBA & 0x3FFFF, DB >> (((A & 1) ^ 1) << 3) );
   return;
  }
 
@@ -1275,7 +1486,10 @@ MDFN_FASTCALL void Write16_DB(uint32 A, uint16 DB)
  {
   VRAMUsageWrite(A >> 1);
   SS_DBGTI(SS_DBG_VDP1_VRAMW, "[VDP1] Write to VRAM: 0x%04x->VRAM[0x%05x]", DB, A);
-  VRAM[A >> 1] = DB;
+  if(MDFN_UNLIKELY(QueueWrites()))
+   WWQ(COMMAND_WRITE16_VRAM, A >> 1, DB);
+  else
+   VRAM[A >> 1] = DB;
   return;
  }
 
@@ -1288,7 +1502,10 @@ MDFN_FASTCALL void Write16_DB(uint32 A, uint16 DB)
   if((TVMR & (TVMR_8BPP | TVMR_ROTATE)) == (TVMR_8BPP | TVMR_ROTATE))
    FBA = (FBA & 0x1FF) | ((FBA << 1) & 0x3FC00) | ((FBA >> 8) & 0x200);
 
-  FB[FBDrawWhich][(FBA >> 1) & 0x1FFFF] = DB;
+  if(MDFN_UNLIKELY(QueueWrites()))
+   WWQ(COMMAND_WRITE16_FB, (FBA >> 1) & 0x1FFFF, DB);
+  else
+   FB[FBDrawWhich][(FBA >> 1) & 0x1FFFF] = DB;
   return;
  }
 
@@ -1300,18 +1517,28 @@ MDFN_FASTCALL uint16 Read16_DB(uint32 A)
  A &= 0x1FFFFE;
 
  if(A < 0x080000)
+ {
+  if(MDFN_UNLIKELY(WritesQueued))
+   Sync();
+
   return VRAM[A >> 1];
+ }
 
  if(A < 0x100000)
  {
   uint32 FBA = A;
 
+  if(DrawingPending || WritesQueued)
+   Sync();
+
   if((TVMR & (TVMR_8BPP | TVMR_ROTATE)) == (TVMR_8BPP | TVMR_ROTATE))
    FBA = (FBA & 0x1FF) | ((FBA << 1) & 0x3FC00) | ((FBA >> 8) & 0x200);
 
   return FB[FBDrawWhich][(FBA >> 1) & 0x1FFFF];
  }
 
+ Sync();
+
  return ReadReg((A - 0x100000) >> 1);
 }
 
@@ -1319,6 +1546,8 @@ void StateAction(StateMem* sm, const unsigned load, const bool data_only)
 {
  bool tmp_abs_dy_gt_abs_dx = false;
 
+ Sync();
+
  SFORMAT Prim_StateRegs[] =
  {
   SFVAR(PrimData.e->d_error, 0x2, sizeof(*PrimData.e), PrimData.e),
@@ -1501,11 +1730,15 @@ void StateAction(StateMem* sm, const unsigned load, const bool data_only)
 
   if(tmp_abs_dy_gt_abs_dx)
    std::swap(LineInnerData.xy_inc[0], LineInnerData.xy_inc[1]);
+
+  DrawingPending = DThread && DrawingActive;
  }
 }
 
 void MakeDump(const std::string& path)
 {
+ Sync();
+
  FileStream fp(path, FileStream::MODE_WRITE);
 
  for(unsigned i = 0; i < 0x40000; i++)
@@ -1518,6 +1751,8 @@ uint32 GetRegister(const unsigned id, char* const special, const uint32 special_
 {
  uint32 ret = 0xDEADBEEF;
 
+ Sync();
+
  switch(id)
  {
   case GSREG_SYSCLIPX:
@@ -1578,6 +1813,8 @@ uint32 GetRegister(const unsigned id, char* const special, const uint32 special_
 
 void SetRegister(const unsigned id, const uint32 value)
 {
+ Sync();
+
  // TODO
  switch(id)
  {
@@ -30,9 +30,12 @@ namespace MDFN_IEN_SS
 namespace VDP1
 {
 
-void Init(void) MDFN_COLD;
+void Init(const bool threaded) MDFN_COLD;
 void Kill(void) MDFN_COLD;
 void StateAction(StateMem* sm, const unsigned load, const bool data_only) MDFN_COLD;
+bool IsThreaded(void);
+// Waits for queued drawing and applies its events, call before saving other modules' state
+void Sync(void);
 
 void Reset(bool powering_up) MDFN_COLD;
 
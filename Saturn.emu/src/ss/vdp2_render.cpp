@@ -34,6 +34,7 @@
 #include <imagine/util/container/RingBuffer.hh>
 
 #include <atomic>
+#include <thread>
 
 namespace MDFN_IEN_SS
 {
@@ -172,7 +173,6 @@ enum
  WINLAYER_CC = 7,
 };
 
-static std::array<unsigned, 5> WinPieces;
 //
 static uint8 SpriteCCCond;
 static uint8 SpriteCCNum;
@@ -183,9 +183,6 @@ static uint16 SDCTL;
 static uint8 SpritePrioNum[8];
 static uint8 SpriteCCRatio[8];
 
-static uint8 SpriteCCLUT[8];	// Temp optimization data
-static uint8 SpriteCC3Mask; 	// Temp optimization data
-
 //
 static uint8 CRAMAddrOffs_NBG[4];
 static uint8 CRAMAddrOffs_RBG0;
@@ -462,7 +459,37 @@ struct RotVars
  TileFetcher<true> tf;
 };
 
-static struct
+//
+// State latched for one line by PrepLine() on the render thread.  Everything ComposeLine() needs
+// that carries over from line to line(line scroll, line window, mosaic and vertical cell scroll
+// counters) is captured here so lines can then be composed in any order.
+//
+struct LineSetup
+{
+ uint16 out_line;
+ uint16 vdp2_line;
+ uint32 back_rgb24;
+ uint32 border_ncf;
+ uint16 CurLCColor;
+
+ uint32 CurXScrollIF[2];
+ uint32 CurYScrollIF[2];
+ uint16 CurXCoordInc[2];
+ uint32 MosEff_YCoordAccum[2];
+ uint16 MosEff_NBG23_YCounter[2];
+
+ bool WinYMet[2];
+ uint16 WinCurXStart[2], WinCurXEnd[2];
+ std::array<unsigned, 5> WinPieces;
+
+ uint16 vcscr[2][88 + 1 + 1];	// + 1 for fine x scroll != 0, + 1 for pointer shenanigans in FetchVCScroll
+};
+
+//
+// Line buffers and scratch data used while composing one line, one instance per thread that
+// composes lines.
+//
+struct LineBuffers
 {
  uint64 spr[704];
  uint64 rbg0[704];
@@ -470,11 +497,6 @@ static struct
  {
   uint64 nbg[4][8 + 704 + 8];
   struct
-  {
-   uint8 dummy[sizeof(nbg) / 2];
-   uint16 vcscr[2][88 + 1 + 1];	// + 1 for fine x scroll != 0, + 1 for pointer shenanigans in FetchVCScroll
-  };
-  struct
   {
    uint8 rotdummy[sizeof(nbg) / 4];
    uint8 rotabsel[352];	// Also used as a scratch buffer in T_DrawRBG() to handle mosaic-related junk.
@@ -483,7 +505,11 @@ static struct
   };
  };
  alignas(16) uint8 lc[704];
-} LB;
+
+ const LineSetup* ls;
+ uint8 SpriteCCLUT[8];	// Temp optimization data
+ uint8 SpriteCC3Mask; 	// Temp optimization data
+};
 
 // ColorOffsEn, etc. ?...hmm, discrepancy with ColorCalcEn and LineColorEn...
 enum
@@ -1214,7 +1240,7 @@ enum
  //SPECIAL_CCALC_SHIFT = 63
 };
 
-static INLINE void GetCWV(const uint8 ctrl, const bool* const xmet, bool* cwv)
+static INLINE void GetCWV(const LineSetup& ls, const uint8 ctrl, const bool* const xmet, bool* cwv)
 {
  const bool logic = (ctrl >> 7) & 1;	// 0 = OR, 1 = AND
  const bool w_enable[2] = { (bool)(ctrl & 0x02), (bool)(ctrl & 0x08) };
@@ -1227,8 +1253,8 @@ static INLINE void GetCWV(const uint8 ctrl, const bool* const xmet, bool* cwv)
   bool wval[2];
   bool swval;
 
-  wval[0] = (w_enable[0] ? ((xmet[0] & Window[0].YMet) ^ w_area[0]) : logic);
-  wval[1] = (w_enable[1] ? ((xmet[1] & Window[1].YMet) ^ w_area[1]) : logic);
+  wval[0] = (w_enable[0] ? ((xmet[0] & ls.WinYMet[0]) ^ w_area[0]) : logic);
+  wval[1] = (w_enable[1] ? ((xmet[1] & ls.WinYMet[1]) ^ w_area[1]) : logic);
 
   swval = sw_enable ? (swinput ^ sw_area) : logic;
 
@@ -1239,22 +1265,24 @@ static INLINE void GetCWV(const uint8 ctrl, const bool* const xmet, bool* cwv)
  }
 }
 
-static void GetWinRotAB(void)
+static void GetWinRotAB(LineBuffers& LB)
 {
+ const LineSetup& ls = *LB.ls;
+ const auto& WinPieces = ls.WinPieces;
  unsigned x = 0;
 
  for(unsigned piece = 0; piece < WinPieces.size(); piece++)
  {
   bool xmet[2];
 
-  xmet[0] = ((x >= Window[0].CurXStart) & (x <= Window[0].CurXEnd));
-  xmet[1] = ((x >= Window[1].CurXStart) & (x <= Window[1].CurXEnd));
+  xmet[0] = ((x >= ls.WinCurXStart[0]) & (x <= ls.WinCurXEnd[0]));
+  xmet[1] = ((x >= ls.WinCurXStart[1]) & (x <= ls.WinCurXEnd[1]));
   //
   //
   //
   bool cwv[2];
 
-  GetCWV(WinControl[WINLAYER_ROTPARAM], xmet, cwv);
+  GetCWV(ls, WinControl[WINLAYER_ROTPARAM], xmet, cwv);
 
   if(HRes & 0x2)
   {
@@ -1269,18 +1297,20 @@ static void GetWinRotAB(void)
  }
 }
 
-static void ApplyWin(const unsigned wlayer, uint64* buf)
+static void ApplyWin(LineBuffers& LB, const unsigned wlayer, uint64* buf)
 {
+ const LineSetup& ls = *LB.ls;
+ const auto& WinPieces = ls.WinPieces;
  unsigned x = 0;
 
- //printf("%d %d %d %d %d --- %d %d\n", WinPieces[0], WinPieces[1], WinPieces[2], WinPieces[3], WinPieces[4], Window[0].CurXStart, Window[0].CurXEnd);
+ //printf("%d %d %d %d %d --- %d %d\n", WinPieces[0], WinPieces[1], WinPieces[2], WinPieces[3], WinPieces[4], ls.WinCurXStart[0], ls.WinCurXEnd[0]);
 
  for(unsigned piece = 0; piece < WinPieces.size(); piece++)
  {
   bool xmet[2];
 
-  xmet[0] = ((x >= Window[0].CurXStart) & (x <= Window[0].CurXEnd));
-  xmet[1] = ((x >= Window[1].CurXStart) & (x <= Window[1].CurXEnd));
+  xmet[0] = ((x >= ls.WinCurXStart[0]) & (x <= ls.WinCurXEnd[0]));
+  xmet[1] = ((x >= ls.WinCurXStart[1]) & (x <= ls.WinCurXEnd[1]));
 
   //
   //
@@ -1288,8 +1318,8 @@ static void ApplyWin(const unsigned wlayer, uint64* buf)
   bool cwv[2];
   bool cc_cwv[2];
 
-  GetCWV(WinControl[wlayer], xmet, cwv);
-  GetCWV(WinControl[WINLAYER_CC], xmet, cc_cwv);
+  GetCWV(ls, WinControl[wlayer], xmet, cwv);
+  GetCWV(ls, WinControl[WINLAYER_CC], xmet, cc_cwv);
 
   if(!((cwv[0] ^ cwv[1]) | (cc_cwv[0] ^ cc_cwv[1])))	// Fast path(no sprite window, or sprite window wouldn't have an effect in this piece).
   {
@@ -1382,7 +1412,7 @@ static NO_INLINE void ApplyHMosaic(const unsigned layer, uint64* buf, const unsi
 //	[Entry 44] [Entry 44] [Entry 0] [Entry 1]
 //
 
-static void FetchVCScroll(const unsigned w)
+static void FetchVCScroll(uint16 (&vcscr)[2][88 + 1 + 1], const unsigned w)
 {
  const bool vcon[2] = { (bool)(SCRCTL & BGON & !(MZCTL & 0x1)), (bool)((SCRCTL >> 8) & (BGON >> 1) & !(MZCTL & 0x2) & 0x1) };
  const unsigned max_cyc = (HRes & 0x6) ? 4 : 8;
@@ -1429,7 +1459,7 @@ static void FetchVCScroll(const unsigned w)
    if(vcon[0])
    {
     if(cyc == 3)
-     LB.vcscr[0][tile] = ((base[0] + tmp[0]) >> 8);
+     vcscr[0][tile] = ((base[0] + tmp[0]) >> 8);
 
     if(cyc == 3)
      tmp[0] = VCLast[0];
@@ -1446,7 +1476,7 @@ static void FetchVCScroll(const unsigned w)
    if(vcon[1])
    {
     if(cyc == 4)
-     LB.vcscr[1][tile] = ((base[1] + tmp[1]) >> 8);
+     vcscr[1][tile] = ((base[1] + tmp[1]) >> 8);
 
     if(cyc == 4)
      tmp[1] = VCLast[1];
@@ -1559,9 +1589,10 @@ static INLINE uint64 MakeNBGRBGPix(T& tf, const uint32 pix_base_or, const int16*
 }
 
 template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
+static void T_DrawNBG(LineBuffers& LB, const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
 {
  assert(n < 2);
+ const LineSetup& ls = *LB.ls;
  //
  //
  const bool VCSEn = ((SCRCTL >> (n << 3)) & 0x1) && !(MZCTL & (1U << n));
@@ -1589,9 +1620,9 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
 
  MakeSFCodeLUT<TA_PrioMode, TA_CCMode>(n, sfcode_lut);
 
- xc = CurXScrollIF[n];
- iy = (CurYScrollIF[n] + MosEff_YCoordAccum[n]) >> 8;
- xcinc = CurXCoordInc[n];
+ xc = ls.CurXScrollIF[n];
+ iy = (ls.CurYScrollIF[n] + ls.MosEff_YCoordAccum[n]) >> 8;
+ xcinc = ls.CurXCoordInc[n];
 
  //if(line == 64)
  // printf("Mega %d: planesize=0x%1x charsize=%d pndsize=%d(auxmode=%d,supp=0x%04x) bpp=%d/%d ccmode=0x%04x SFSEL=0x%04x SFCODE=0x%04x SFCCMD=0x%04x\n", n, PlaneSize, CharSize, PNDSize, AuxMode, Supp, TA_bpp, TA_isrgb, TA_CCMode, SFSEL, SFCODE, SFCCMD);
@@ -1610,7 +1641,7 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
   for(unsigned i = 0; MDFN_LIKELY(i < w); i++)
   {
    const uint32 ix = xc >> 8;
-   iy = LB.vcscr[n][i >> 3];
+   iy = ls.vcscr[n][i >> 3];
    tf.Fetch<TA_bpp>(TA_bmen, ix, iy);
    //
    //
@@ -1630,7 +1661,7 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
     prev_ix = ix >> 3;
     //
     if(VCSEn)
-     iy = LB.vcscr[n][(i + 7) >> 3];
+     iy = ls.vcscr[n][(i + 7) >> 3];
 
     tf.Fetch<TA_bpp>(TA_bmen, ix, iy);
    }
@@ -1643,7 +1674,7 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
  }
 }
 
-static void (*DrawNBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
+static void (*DrawNBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(LineBuffers& LB, const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
 {
  {
   {  {  { T_DrawNBG<0, 4, 0, 0, 0, 0>, T_DrawNBG<0, 4, 0, 0, 0, 1>, T_DrawNBG<0, 4, 0, 0, 0, 2>, T_DrawNBG<0, 4, 0, 0, 0, 3>,  },  { T_DrawNBG<0, 4, 0, 0, 1, 0>, T_DrawNBG<0, 4, 0, 0, 1, 1>, T_DrawNBG<0, 4, 0, 0, 1, 2>, T_DrawNBG<0, 4, 0, 0, 1, 3>,  },  { T_DrawNBG<0, 4, 0, 0, 2, 0>, T_DrawNBG<0, 4, 0, 0, 2, 1>, T_DrawNBG<0, 4, 0, 0, 2, 2>, T_DrawNBG<0, 4, 0, 0, 2, 3>,  },  },  {  { T_DrawNBG<0, 4, 0, 1, 0, 0>, T_DrawNBG<0, 4, 0, 1, 0, 1>, T_DrawNBG<0, 4, 0, 1, 0, 2>, T_DrawNBG<0, 4, 0, 1, 0, 3>,  },  { T_DrawNBG<0, 4, 0, 1, 1, 0>, T_DrawNBG<0, 4, 0, 1, 1, 1>, T_DrawNBG<0, 4, 0, 1, 1, 2>, T_DrawNBG<0, 4, 0, 1, 1, 3>,  },  { T_DrawNBG<0, 4, 0, 1, 2, 0>, T_DrawNBG<0, 4, 0, 1, 2, 1>, T_DrawNBG<0, 4, 0, 1, 2, 2>, T_DrawNBG<0, 4, 0, 1, 2, 3>,  },  },  },
@@ -1684,14 +1715,14 @@ static INLINE uint64 MakeNBG23Pix(uint32 dcc, uint32 pbor, const int16* sfcode_l
 // CCMode will be forced to 0 in the effective instantiation if corresponding NBG CCE bit in CCCTL is 0.
 //
 template<unsigned TA_bpp, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
+static void T_DrawNBG23(LineBuffers& LB, const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
 {
  assert(n >= 2);
  TileFetcher<false> tf;
  int16 sfcode_lut[8];
  unsigned tc = 1 + (w >> 3);
  const unsigned xscr = XScrollI[n];
- const unsigned yscr = MosEff_NBG23_YCounter[n & 1];
+ const unsigned yscr = LB.ls->MosEff_NBG23_YCounter[n & 1];
  unsigned tx;
 
  tf.CRAOffs = CRAMAddrOffs_NBG[n] << 8;
@@ -1807,7 +1838,7 @@ static void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const
  }
 }
 
-static void (*DrawNBG23[2/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
+static void (*DrawNBG23[2/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(LineBuffers& LB, const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
 {
  {
   {    { T_DrawNBG23<4, 0, 0, 0>, T_DrawNBG23<4, 0, 0, 1>, T_DrawNBG23<4, 0, 0, 2>, T_DrawNBG23<4, 0, 0, 3>, },    { T_DrawNBG23<4, 0, 1, 0>, T_DrawNBG23<4, 0, 1, 1>, T_DrawNBG23<4, 0, 1, 2>, T_DrawNBG23<4, 0, 1, 3>, },    { T_DrawNBG23<4, 0, 2, 0>, T_DrawNBG23<4, 0, 2, 1>, T_DrawNBG23<4, 0, 2, 2>, T_DrawNBG23<4, 0, 2, 3>, }, },
@@ -1859,7 +1890,7 @@ static INLINE uint32 ReadCoeff(const unsigned i, const uint32 addr)
 // RBG1 requires RPMD == 0, or else bad things happen?
 
 template<typename T>
-static void SetupRotVars(const T* rs, const unsigned rbg_w)
+static void SetupRotVars(LineBuffers& LB, const T* rs, const unsigned rbg_w)
 {
  const uint8 EffRPMD = ((BGON & 0x20) ? 0 : RPMD);
 
@@ -1869,7 +1900,7 @@ static void SetupRotVars(const T* rs, const unsigned rbg_w)
    LB.rotabsel[x] = RPMD;
  }
  else if(EffRPMD == 3)
-  GetWinRotAB();
+  GetWinRotAB(LB);
 
  //
  //
@@ -2010,7 +2041,7 @@ static void SetupRotVars(const T* rs, const unsigned rbg_w)
 
 // const bool TA_bmen = ((rn == 1) ? false : ((CHCTLB >> 9) & 1));
 template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void T_DrawRBG(const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
+static void T_DrawRBG(LineBuffers& LB, const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
 {
  // Full color format selection for both RBG0 and RBG1
  // Bitmap only allowed for RBG0
@@ -2064,7 +2095,7 @@ static void T_DrawRBG(const bool rn, uint64* bgbuf, const unsigned w, const uint
 }
 
 //template<unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void (*DrawRBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
+static void (*DrawRBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(LineBuffers& LB, const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
 {
  {
   {  {  { T_DrawRBG<0, 4, 0, 0, 0, 0>, T_DrawRBG<0, 4, 0, 0, 0, 1>, T_DrawRBG<0, 4, 0, 0, 0, 2>, T_DrawRBG<0, 4, 0, 0, 0, 3>,  },  { T_DrawRBG<0, 4, 0, 0, 1, 0>, T_DrawRBG<0, 4, 0, 0, 1, 1>, T_DrawRBG<0, 4, 0, 0, 1, 2>, T_DrawRBG<0, 4, 0, 0, 1, 3>,  },  { T_DrawRBG<0, 4, 0, 0, 2, 0>, T_DrawRBG<0, 4, 0, 0, 2, 1>, T_DrawRBG<0, 4, 0, 0, 2, 2>, T_DrawRBG<0, 4, 0, 0, 2, 3>,  },  },  {  { T_DrawRBG<0, 4, 0, 1, 0, 0>, T_DrawRBG<0, 4, 0, 1, 0, 1>, T_DrawRBG<0, 4, 0, 1, 0, 2>, T_DrawRBG<0, 4, 0, 1, 0, 3>,  },  { T_DrawRBG<0, 4, 0, 1, 1, 0>, T_DrawRBG<0, 4, 0, 1, 1, 1>, T_DrawRBG<0, 4, 0, 1, 1, 2>, T_DrawRBG<0, 4, 0, 1, 1, 3>,  },  { T_DrawRBG<0, 4, 0, 1, 2, 0>, T_DrawRBG<0, 4, 0, 1, 2, 1>, T_DrawRBG<0, 4, 0, 1, 2, 2>, T_DrawRBG<0, 4, 0, 1, 2, 3>,  },  },  },
@@ -2094,7 +2125,7 @@ static INLINE void Doubleize(T* ptr, const int orig_len)
  }
 }
 
-static void RBGPP(const unsigned layer, uint64* buf, const unsigned rbg_w)
+static void RBGPP(LineBuffers& LB, const unsigned layer, uint64* buf, const unsigned rbg_w)
 {
  ApplyHMosaic(layer, buf, rbg_w);
 
@@ -2111,11 +2142,11 @@ static void RBGPP(const unsigned layer, uint64* buf, const unsigned rbg_w)
  if(HRes & 0x2)
   Doubleize(buf, rbg_w);
 
- ApplyWin(layer, buf);
+ ApplyWin(LB, layer, buf);
 }
 
 // Call before DrawSpriteData()
-static INLINE void MakeSpriteCCLUT(void)
+static INLINE void MakeSpriteCCLUT(LineBuffers& LB)
 {
  const bool cce = ((CCCTL >> 6) & 1);
 
@@ -2129,16 +2160,16 @@ static INLINE void MakeSpriteCCLUT(void)
    case 1: mask = (SpritePrioNum[pr] == SpriteCCNum); break;
    case 2: mask = (SpritePrioNum[pr] >= SpriteCCNum); break;
   }
-  SpriteCCLUT[pr] = (cce & mask) << PIX_CCE_SHIFT;
+  LB.SpriteCCLUT[pr] = (cce & mask) << PIX_CCE_SHIFT;
  }
 
- SpriteCC3Mask = 0;
+ LB.SpriteCC3Mask = 0;
  if(SpriteCCCond == 3 && cce)
-  SpriteCC3Mask = 1U << PIX_CCE_SHIFT;
+  LB.SpriteCC3Mask = 1U << PIX_CCE_SHIFT;
 }
 
 template<bool TA_HiRes, bool TA_TPShadSel, unsigned TA_SPCTL_Low>
-static void T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsigned w)
+static void T_DrawSpriteData(LineBuffers& LB, const uint16* vdp1sb, const bool vdp1_hires8, unsigned w)
 {
  const unsigned SpriteType = (TA_SPCTL_Low & 0xF);
  const bool SpriteWinEn = (TA_SPCTL_Low & 0x10);
@@ -2174,7 +2205,7 @@ static void T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsig
   {
    spix = (uint64)rgb15_to_rgb24(src) << PIX_RGB_SHIFT;
    spix |= 1U << PIX_ISRGB_SHIFT;
-   spix |= SpriteCC3Mask;
+   spix |= LB.SpriteCC3Mask;
 
    if(SpriteType & 0x8)
     tp = !(src & 0xFF);
@@ -2318,7 +2349,7 @@ static void T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsig
 
    spix = (uint64)rgb24 << PIX_RGB_SHIFT;
 
-   spix |= ((int32)rgb24 >> 31) & SpriteCC3Mask;
+   spix |= ((int32)rgb24 >> 31) & LB.SpriteCC3Mask;
 
    if(SpriteWinEn)	// Sprite window enable
     spix |= ((uint64)sd << PIX_SWBIT_SHIFT);
@@ -2347,13 +2378,13 @@ static void T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsig
   spix |= spix_base_or;
   spix |= (tp ? 0 : SpritePrioNum[pr]) << PIX_PRIO_SHIFT;
   spix |= SpriteCCRatio[cc] << PIX_CCRATIO_SHIFT;
-  spix |= SpriteCCLUT[pr];
+  spix |= LB.SpriteCCLUT[pr];
 
   LB.spr[i] = spix;
  }
 }
 
-static void (*DrawSpriteData[2][2][0x40])(const uint16* vdp1sb, const bool vdp1_hires8, unsigned w) =
+static void (*DrawSpriteData[2][2][0x40])(LineBuffers& LB, const uint16* vdp1sb, const bool vdp1_hires8, unsigned w) =
 {
  {
   { T_DrawSpriteData<0, 0, 0x00>, T_DrawSpriteData<0, 0, 0x01>, T_DrawSpriteData<0, 0, 0x02>, T_DrawSpriteData<0, 0, 0x03>, T_DrawSpriteData<0, 0, 0x04>, T_DrawSpriteData<0, 0, 0x05>, T_DrawSpriteData<0, 0, 0x06>, T_DrawSpriteData<0, 0, 0x07>, T_DrawSpriteData<0, 0, 0x08>, T_DrawSpriteData<0, 0, 0x09>, T_DrawSpriteData<0, 0, 0x0a>, T_DrawSpriteData<0, 0, 0x0b>, T_DrawSpriteData<0, 0, 0x0c>, T_DrawSpriteData<0, 0, 0x0d>, T_DrawSpriteData<0, 0, 0x0e>, T_DrawSpriteData<0, 0, 0x0f>, T_DrawSpriteData<0, 0, 0x10>, T_DrawSpriteData<0, 0, 0x11>, T_DrawSpriteData<0, 0, 0x12>, T_DrawSpriteData<0, 0, 0x13>, T_DrawSpriteData<0, 0, 0x14>, T_DrawSpriteData<0, 0, 0x15>, T_DrawSpriteData<0, 0, 0x16>, T_DrawSpriteData<0, 0, 0x17>, T_DrawSpriteData<0, 0, 0x18>, T_DrawSpriteData<0, 0, 0x19>, T_DrawSpriteData<0, 0, 0x1a>, T_DrawSpriteData<0, 0, 0x1b>, T_DrawSpriteData<0, 0, 0x1c>, T_DrawSpriteData<0, 0, 0x1d>, T_DrawSpriteData<0, 0, 0x1e>, T_DrawSpriteData<0, 0, 0x1f>, T_DrawSpriteData<0, 0, 0x20>, T_DrawSpriteData<0, 0, 0x21>, T_DrawSpriteData<0, 0, 0x22>, T_DrawSpriteData<0, 0, 0x23>, T_DrawSpriteData<0, 0, 0x24>, T_DrawSpriteData<0, 0, 0x25>, T_DrawSpriteData<0, 0, 0x26>, T_DrawSpriteData<0, 0, 0x27>, T_DrawSpriteData<0, 0, 0x28>, T_DrawSpriteData<0, 0, 0x29>, T_DrawSpriteData<0, 0, 0x2a>, T_DrawSpriteData<0, 0, 0x2b>, T_DrawSpriteData<0, 0, 0x2c>, T_DrawSpriteData<0, 0, 0x2d>, T_DrawSpriteData<0, 0, 0x2e>, T_DrawSpriteData<0, 0, 0x2f>, T_DrawSpriteData<0, 0, 0x30>, T_DrawSpriteData<0, 0, 0x31>, T_DrawSpriteData<0, 0, 0x32>, T_DrawSpriteData<0, 0, 0x33>, T_DrawSpriteData<0, 0, 0x34>, T_DrawSpriteData<0, 0, 0x35>, T_DrawSpriteData<0, 0, 0x36>, T_DrawSpriteData<0, 0, 0x37>, T_DrawSpriteData<0, 0, 0x38>, T_DrawSpriteData<0, 0, 0x39>, T_DrawSpriteData<0, 0, 0x3a>, T_DrawSpriteData<0, 0, 0x3b>, T_DrawSpriteData<0, 0, 0x3c>, T_DrawSpriteData<0, 0, 0x3d>, T_DrawSpriteData<0, 0, 0x3e>, T_DrawSpriteData<0, 0, 0x3f> },
@@ -2380,10 +2411,10 @@ enum
 };
 
 template<bool TA_rbgdualen, unsigned TA_Special, bool TA_CCRTMD, bool TA_CCMD>
-static void T_MixIt(uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc)
+static void T_MixIt(LineBuffers& LB, uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc)
 {
  //printf("MixIt: %d, %d, %d, %d\n", TA_rbgdualen, TA_Special, TA_CCRTMD, TA_CCMD);
- const uint32* lclut = &ColorCache[CurLCColor &~ 0x7F];
+ const uint32* lclut = &ColorCache[LB.ls->CurLCColor &~ 0x7F];
  uint32 blurprev[2];
 
  if(TA_Special == MIXIT_SPECIAL_GRAD)
@@ -2612,7 +2643,7 @@ static void T_MixIt(uint32* target, const unsigned vdp2_line, const unsigned w,
 }
 
 //template<bool TA_rbgdualen, unsigned TA_Special, bool TA_CCRTMD, bool TA_CCMD>
-static void (*MixIt[2][7][2][2])(uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc) =
+static void (*MixIt[2][7][2][2])(LineBuffers& LB, uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc) =
 {
  {  {  { T_MixIt<0, 0, 0, 0>, T_MixIt<0, 0, 0, 1>,  },  { T_MixIt<0, 0, 1, 0>, T_MixIt<0, 0, 1, 1>,  },  },  {  { T_MixIt<0, 1, 0, 0>, T_MixIt<0, 1, 0, 1>,  },  { T_MixIt<0, 1, 1, 0>, T_MixIt<0, 1, 1, 1>,  },  },  {  { T_MixIt<0, 2, 0, 0>, T_MixIt<0, 2, 0, 1>,  },  { T_MixIt<0, 2, 1, 0>, T_MixIt<0, 2, 1, 1>,  },  },  {  { T_MixIt<0, 3, 0, 0>, T_MixIt<0, 3, 0, 1>,  },  { T_MixIt<0, 3, 1, 0>, T_MixIt<0, 3, 1, 1>,  },  },  {  { T_MixIt<0, 4, 0, 0>, T_MixIt<0, 4, 0, 1>,  },  { T_MixIt<0, 4, 1, 0>, T_MixIt<0, 4, 1, 1>,  },  },  {  { T_MixIt<0, 5, 0, 0>, T_MixIt<0, 5, 0, 1>,  },  { T_MixIt<0, 5, 1, 0>, T_MixIt<0, 5, 1, 1>,  },  },  {  { T_MixIt<0, 6, 0, 0>, T_MixIt<0, 6, 0, 1>,  },  { T_MixIt<0, 6, 1, 0>, T_MixIt<0, 6, 1, 1>,  },  },  },
  {  {  { T_MixIt<1, 0, 0, 0>, T_MixIt<1, 0, 0, 1>,  },  { T_MixIt<1, 0, 1, 0>, T_MixIt<1, 0, 1, 1>,  },  },  {  { T_MixIt<1, 1, 0, 0>, T_MixIt<1, 1, 0, 1>,  },  { T_MixIt<1, 1, 1, 0>, T_MixIt<1, 1, 1, 1>,  },  },  {  { T_MixIt<1, 2, 0, 0>, T_MixIt<1, 2, 0, 1>,  },  { T_MixIt<1, 2, 1, 0>, T_MixIt<1, 2, 1, 1>,  },  },  {  { T_MixIt<1, 3, 0, 0>, T_MixIt<1, 3, 0, 1>,  },  { T_MixIt<1, 3, 1, 0>, T_MixIt<1, 3, 1, 1>,  },  },  {  { T_MixIt<1, 4, 0, 0>, T_MixIt<1, 4, 0, 1>,  },  { T_MixIt<1, 4, 1, 0>, T_MixIt<1, 4, 1, 1>,  },  },  {  { T_MixIt<1, 5, 0, 0>, T_MixIt<1, 5, 0, 1>,  },  { T_MixIt<1, 5, 1, 0>, T_MixIt<1, 5, 1, 1>,  },  },  {  { T_MixIt<1, 6, 0, 0>, T_MixIt<1, 6, 0, 1>,  },  { T_MixIt<1, 6, 1, 0>, T_MixIt<1, 6, 1, 1>,  },  },  },
@@ -2696,34 +2727,16 @@ static void ReorderRGB(uint32* target, const unsigned w, const unsigned Rshift,
  }
 }
 
-static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, const bool field)
+//
+// Runs in line order on the render thread; advances all the state that carries over from one line to the next.
+//
+static NO_INLINE void PrepLine(LineSetup& ls, const uint16 out_line, const uint16 vdp2_line, const bool field)
 {
- if(espec->skip)
-  return;
- uint32* target;
- const int32 tvdw = ((!CorrectAspect || Clock28M) ? 352 : 330) << ((HRes & 0x2) >> 1);
- const unsigned rbg_w = ((HRes & 0x1) ? 352 : 320);
  const unsigned w = ((HRes & 0x1) ? 352 : 320) << ((HRes & 0x2) >> 1);
- const int32 tvxo = std::max<int32>(0, (int32)(tvdw - w) >> 1);
  uint32 back_rgb24;
- uint32 border_ncf;
 
- target = espec->surface->pixels + out_line * espec->surface->pitchinpix;
- espec->LineWidths[out_line] = tvdw;
-
- if(!ShowHOverscan)
- {
-  const int32 ntdw = tvdw * 1024 / 1056;
-  const int32 tadj = std::max<int32>(0, espec->DisplayRect.x - ((tvdw - ntdw) >> 1));
-
-  //if(out_line == 100)
-  // printf("tvdw=%d, ntdw=%d, tadj=%d --- tvdw+tadj=%d\n", tvdw, ntdw, tadj, tvdw + tadj);
-
-  assert((tvdw + tadj) <= 704);
-
-  target += tadj;
-  espec->LineWidths[out_line] = ntdw;
- }
+ ls.out_line = out_line;
+ ls.vdp2_line = vdp2_line;
 
  //
  // FIXME: Timing
@@ -2777,17 +2790,15 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
 
  back_rgb24 = rgb15_to_rgb24(CurBackColor);
 
+ ls.back_rgb24 = back_rgb24;
+ ls.CurLCColor = CurLCColor;
+
  if(BorderMode)
-  border_ncf = espec->surface->MakeColor((uint8)(back_rgb24 >> 0), (uint8)(back_rgb24 >> 8), (uint8)(back_rgb24 >> 16));
+  ls.border_ncf = espec->surface->MakeColor((uint8)(back_rgb24 >> 0), (uint8)(back_rgb24 >> 8), (uint8)(back_rgb24 >> 16));
  else
-  border_ncf = espec->surface->MakeColor(0, 0, 0);
+  ls.border_ncf = espec->surface->MakeColor(0, 0, 0);
 
- if(vdp2_line == 0xFFFF)
- {
-  for(int32 i = 0; i < tvdw; i++)
-   target[i] = border_ncf;
- }
- else
+ if(vdp2_line != 0xFFFF)
  {
   //
   // Line scroll
@@ -2896,16 +2907,16 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    //
    //
    //
-   WinPieces[0] = Window[0].CurXStart;
-   WinPieces[1] = Window[0].CurXEnd + 1;
-   WinPieces[2] = Window[1].CurXStart;
-   WinPieces[3] = Window[1].CurXEnd + 1;
-   WinPieces[4] = w;
+   ls.WinPieces[0] = Window[0].CurXStart;
+   ls.WinPieces[1] = Window[0].CurXEnd + 1;
+   ls.WinPieces[2] = Window[1].CurXStart;
+   ls.WinPieces[3] = Window[1].CurXEnd + 1;
+   ls.WinPieces[4] = w;
 
-   for(unsigned piece = 0; piece < WinPieces.size(); piece++)
-    WinPieces[piece] = std::min<unsigned>(w, WinPieces[piece]);	// Almost forgot to do this...
+   for(unsigned piece = 0; piece < ls.WinPieces.size(); piece++)
+    ls.WinPieces[piece] = std::min<unsigned>(w, ls.WinPieces[piece]);	// Almost forgot to do this...
 
-   std::sort(WinPieces.begin(), WinPieces.end());
+   std::sort(ls.WinPieces.begin(), ls.WinPieces.end());
   }
 
   //
@@ -2918,14 +2929,111 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    //printf("WinControl[WINLAYER_CC]=%02x\n", WinControl[WINLAYER_CC]);
   }
 
+  //
+  //
+  //
+  for(unsigned n = 0; n < 4; n++)
+  {
+   if(!MosaicVCount || !(MZCTL & (1U << n)))
+   {
+    if(n < 2)
+    {
+     MosEff_YCoordAccum[n] = YCoordAccum[n];	// Don't + (InterlaceMode == IM_DOUBLE && field)
+    }
+    else
+    {
+     MosEff_NBG23_YCounter[n & 1] = NBG23_YCounter[n & 1] + (InterlaceMode == IM_DOUBLE && field);
+    }
+   }
+  }
+
+  if(SCRCTL & 0x0101)
+   FetchVCScroll(ls.vcscr, w);	// Call after handling line scroll, and before DrawNBG() stuff
+
+  for(unsigned n = 0; n < 2; n++)
+  {
+   ls.CurXScrollIF[n] = CurXScrollIF[n];
+   ls.CurYScrollIF[n] = CurYScrollIF[n];
+   ls.CurXCoordInc[n] = CurXCoordInc[n];
+   ls.MosEff_YCoordAccum[n] = MosEff_YCoordAccum[n];
+   ls.MosEff_NBG23_YCounter[n] = MosEff_NBG23_YCounter[n];
+  }
+
+  for(unsigned d = 0; d < 2; d++)
+  {
+   ls.WinYMet[d] = Window[d].YMet;
+   ls.WinCurXStart[d] = Window[d].CurXStart;
+   ls.WinCurXEnd[d] = Window[d].CurXEnd;
+  }
+
+  //
+  //
+  //
+  // FIXME: Timing
+  //
+  for(unsigned n = 0; n < 2; n++)
+  {
+   YCoordAccum[n] += YCoordInc[n] << (InterlaceMode == IM_DOUBLE);
+   NBG23_YCounter[n & 1] += 1 << (InterlaceMode == IM_DOUBLE);
+  }
+
+  if(MosaicVCount >= ((MZCTL >> 12) & 0xF))
+   MosaicVCount = 0;
+  else
+   MosaicVCount++;
+ }
+}
+
+//
+// Only reads state latched in the LineSetup and registers/VRAM/CRAM that stay unchanged until the line
+// is done, so lines can be composed on any thread, each with its own LineBuffers.
+//
+static NO_INLINE void ComposeLine(LineBuffers& LB, const LineSetup& ls)
+{
+ const uint16 out_line = ls.out_line;
+ const uint16 vdp2_line = ls.vdp2_line;
+ uint32* target;
+ const int32 tvdw = ((!CorrectAspect || Clock28M) ? 352 : 330) << ((HRes & 0x2) >> 1);
+ const unsigned rbg_w = ((HRes & 0x1) ? 352 : 320);
+ const unsigned w = ((HRes & 0x1) ? 352 : 320) << ((HRes & 0x2) >> 1);
+ const int32 tvxo = std::max<int32>(0, (int32)(tvdw - w) >> 1);
+ const uint32 back_rgb24 = ls.back_rgb24;
+ const uint32 border_ncf = ls.border_ncf;
+
+ LB.ls = &ls;
+
+ target = espec->surface->pixels + out_line * espec->surface->pitchinpix;
+ espec->LineWidths[out_line] = tvdw;
+
+ if(!ShowHOverscan)
+ {
+  const int32 ntdw = tvdw * 1024 / 1056;
+  const int32 tadj = std::max<int32>(0, espec->DisplayRect.x - ((tvdw - ntdw) >> 1));
+
+  //if(out_line == 100)
+  // printf("tvdw=%d, ntdw=%d, tadj=%d --- tvdw+tadj=%d\n", tvdw, ntdw, tadj, tvdw + tadj);
+
+  assert((tvdw + tadj) <= 704);
+
+  target += tadj;
+  espec->LineWidths[out_line] = ntdw;
+ }
+
+ if(vdp2_line == 0xFFFF)
+ {
+  for(int32 i = 0; i < tvdw; i++)
+   target[i] = border_ncf;
+ }
+ else
+ {
   //
   // Process sprite data before NBG0-3 and RBG0-1, but defer applying the window until after NBG and RBG are handled(so the sprite window
   // bit in the sprite linebuffer data isn't trashed prematurely).
   //
   if(MDFN_LIKELY(UserLayerEnableMask & (1U << 6)))
   {
-   MakeSpriteCCLUT();
-   DrawSpriteData[(HRes & 0x2) >> 0x1][(SDCTL >> 8) & 0x1][SPCTL_Low](LIB[vdp2_line].vdp1_line, LIB[vdp2_line].vdp1_hires8, w);
+   MakeSpriteCCLUT(LB);
+   DrawSpriteData[(HRes & 0x2) >> 0x1][(SDCTL >> 8) & 0x1][SPCTL_Low](LB, LIB[vdp2_line].vdp1_line, LIB[vdp2_line].vdp1_hires8, w);
   }
   else
    MDFN_FastArraySet(LB.spr, 0, w);
@@ -2938,8 +3046,8 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
   //
   if(BGON & 0x30)
   {
-   MDFN_FastArraySet(LB.lc, CurLCColor & 0x7F, rbg_w);
-   SetupRotVars(LIB[vdp2_line].rv, rbg_w);
+   MDFN_FastArraySet(LB.lc, ls.CurLCColor & 0x7F, rbg_w);
+   SetupRotVars(LB, LIB[vdp2_line].rv, rbg_w);
    if(HRes & 0x2)
     Doubleize(LB.lc, rbg_w);
 
@@ -2971,8 +3079,8 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
     else
      pix_base_or |= (prio << PIX_PRIO_SHIFT);
 
-    DrawRBG[bmen][colornum][igntp][priomode % 3][ccmode](0, LB.rbg0, rbg_w, pix_base_or);
-    RBGPP(4, LB.rbg0, rbg_w);
+    DrawRBG[bmen][colornum][igntp][priomode % 3][ccmode](LB, 0, LB.rbg0, rbg_w, pix_base_or);
+    RBGPP(LB, 4, LB.rbg0, rbg_w);
    }
    else
     MDFN_FastArraySet(LB.rbg0, 0, w);
@@ -3005,38 +3113,20 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
      pix_base_or |= (prio << PIX_PRIO_SHIFT);
 
     MDFN_FastArraySet(LB.rotabsel, 1, rbg_w);
-    DrawRBG[false][colornum][igntp][priomode % 3][ccmode](1, LB.nbg[0] + 8, rbg_w, pix_base_or);
-    RBGPP(0, LB.nbg[0] + 8, rbg_w);
+    DrawRBG[false][colornum][igntp][priomode % 3][ccmode](LB, 1, LB.nbg[0] + 8, rbg_w, pix_base_or);
+    RBGPP(LB, 0, LB.nbg[0] + 8, rbg_w);
    }
    else if(BGON & 0x20)
     MDFN_FastArraySet(LB.nbg[0] + 8, 0, w);
   }
   else
   {
-   MDFN_FastArraySet(LB.lc, CurLCColor & 0x7F, w);
+   MDFN_FastArraySet(LB.lc, ls.CurLCColor & 0x7F, w);
    MDFN_FastArraySet(LB.rbg0, 0, w);
   }
   //
   //
   //
-  for(unsigned n = 0; n < 4; n++)
-  {
-   if(!MosaicVCount || !(MZCTL & (1U << n)))
-   {
-    if(n < 2)
-    {
-     MosEff_YCoordAccum[n] = YCoordAccum[n];	// Don't + (InterlaceMode == IM_DOUBLE && field)
-    }
-    else
-    {
-     MosEff_NBG23_YCounter[n & 1] = NBG23_YCounter[n & 1] + (InterlaceMode == IM_DOUBLE && field);
-    }
-   }
-  }
-
-  if(SCRCTL & 0x0101)
-   FetchVCScroll(w);	// Call after handling line scroll, and before DrawNBG() stuff
-
   if((BGON & 0x30) != 0x30)
   {
    for(unsigned n = (bool)(BGON & 0x20); n < 4; n++)
@@ -3093,12 +3183,12 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
       pix_base_or |= (prio << PIX_PRIO_SHIFT);
 
      if(n < 2)
-      DrawNBG[bmen][colornum][igntp][priomode % 3][ccmode](n, LB.nbg[n] + 8, w, pix_base_or);
+      DrawNBG[bmen][colornum][igntp][priomode % 3][ccmode](LB, n, LB.nbg[n] + 8, w, pix_base_or);
      else
-      DrawNBG23[colornum][igntp][priomode % 3][ccmode](n, LB.nbg[n] + 8, w, pix_base_or);
+      DrawNBG23[colornum][igntp][priomode % 3][ccmode](LB, n, LB.nbg[n] + 8, w, pix_base_or);
 
      ApplyHMosaic(n, LB.nbg[n] + 8, w);
-     ApplyWin(n, LB.nbg[n] + 8);
+     ApplyWin(LB, n, LB.nbg[n] + 8);
     }
     else
      MDFN_FastArraySet(LB.nbg[n] + 8, 0, w);
@@ -3111,7 +3201,7 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
   //
   //
   // Apply window to sprite linebuffer after BG layers have windows applied.
-  ApplyWin(WINLAYER_SPRITE, LB.spr);
+  ApplyWin(LB, WINLAYER_SPRITE, LB.spr);
 
   //
   for(int32 i = 0; i < tvxo; i++)
@@ -3125,9 +3215,9 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    unsigned special = MIXIT_SPECIAL_NONE;
    const bool CCRTMD = (bool)(CCCTL & 0x0200);
    const bool CCMD = (bool)(CCCTL & 0x0100);
-   static const uint64* blurremap[8] = { LB.spr, LB.rbg0, LB.nbg[0] + 8, /*Dummy:*/LB.spr,
-					 LB.nbg[1] + 8, LB.nbg[2] + 8, LB.nbg[3] + 8, /*Dummy:*/LB.spr
-				       };
+   const uint64* blurremap[8] = { LB.spr, LB.rbg0, LB.nbg[0] + 8, /*Dummy:*/LB.spr,
+				  LB.nbg[1] + 8, LB.nbg[2] + 8, LB.nbg[3] + 8, /*Dummy:*/LB.spr
+				};
    const uint64* blursrc = blurremap[(CCCTL >> 12) & 0x7];
 
    if(!(HRes & 0x6))
@@ -3150,25 +3240,10 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
      special = MIXIT_SPECIAL_HIRES_CRAM12;
    }
 
-   MixIt[rbgdualen][special][CCRTMD][CCMD](target + tvxo, vdp2_line, w, back_rgb24, blursrc);
+   MixIt[rbgdualen][special][CCRTMD][CCMD](LB, target + tvxo, vdp2_line, w, back_rgb24, blursrc);
    ReorderRGB(target + tvxo, w, espec->surface->format.Rshift, espec->surface->format.Gshift, espec->surface->format.Bshift);
   }
 
-  //
-  //
-  //
-  // FIXME: Timing
-  //
-  for(unsigned n = 0; n < 2; n++)
-  {
-   YCoordAccum[n] += YCoordInc[n] << (InterlaceMode == IM_DOUBLE);
-   NBG23_YCounter[n & 1] += 1 << (InterlaceMode == IM_DOUBLE);
-  }
-
-  if(MosaicVCount >= ((MZCTL >> 12) & 0xF))
-   MosaicVCount = 0;
-  else
-   MosaicVCount++;
  }
 
  //
@@ -3218,14 +3293,121 @@ static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
  WQ.push({command, arg16, arg32}, {.blocking = true, .flushSize = 64});
 }
 
+//
+// Line setups queued by the render thread, composed in bands of BandLines lines by the render
+// thread together with up to NumBandThreads band threads.  Every queued line only depends on
+// its LineSetup and on register/VRAM/CRAM contents, so the queue is flushed before any command
+// other than COMMAND_DRAW_LINE is processed.
+//
+enum : unsigned { LineQueueSize = 64 };
+enum : unsigned { BandLines = 4 };
+
+static LineSetup LineQueue[LineQueueSize];
+static unsigned LineQueueCount;
+
+static unsigned NumBandThreads;
+static MThreading::Thread* BandThreads[VDP2REND_MaxBandThreads];
+static std::array<IG::ThreadId, VDP2REND_MaxBandThreads> BandThreadIds{};
+static MThreading::Sem* BandStartSem = NULL;
+static MThreading::Sem* BandDoneSem = NULL;
+static std::atomic<unsigned> BandNext;
+static unsigned BandCount;
+static bool BandExit;
+static LineBuffers BandLB[1 + VDP2REND_MaxBandThreads];
+
+static void ComposeBands(LineBuffers& LB)
+{
+ unsigned band;
+
+ while((band = BandNext.fetch_add(1, std::memory_order_relaxed)) < BandCount)
+ {
+  const unsigned first = band * BandLines;
+  const unsigned bound = std::min<unsigned>(first + BandLines, LineQueueCount);
+
+  for(unsigned i = first; i < bound; i++)
+   ComposeLine(LB, LineQueue[i]);
+ }
+}
+
+static int BandThreadEntry(void* data)
+{
+ const unsigned idx = (uintptr_t)data;
+
+ // VDP2REND_Init() waits for this post before returning so the ID is visible to other threads
+ BandThreadIds[idx] = IG::thisThreadId();
+ MThreading::Sem_Post(BandDoneSem);
+
+ for(;;)
+ {
+  MThreading::Sem_Wait(BandStartSem);
+
+  if(BandExit)
+   break;
+
+  ComposeBands(BandLB[1 + idx]);
+  MThreading::Sem_Post(BandDoneSem);
+ }
+
+ return 0;
+}
+
+static void FlushLines(void)
+{
+ if(!LineQueueCount)
+  return;
+
+ BandCount = (LineQueueCount + BandLines - 1) / BandLines;
+ BandNext.store(0, std::memory_order_relaxed);
+
+ const unsigned wake_count = std::min<unsigned>(NumBandThreads, BandCount - 1);
+
+ for(unsigned i = 0; i < wake_count; i++)
+  MThreading::Sem_Post(BandStartSem);
+
+ ComposeBands(BandLB[0]);
+
+ for(unsigned i = 0; i < wake_count; i++)
+  MThreading::Sem_Wait(BandDoneSem);
+
+ LineQueueCount = 0;
+}
+
 static int RThreadEntry(void* data)
 {
  RThreadId = IG::thisThreadId();
 
- auto nextCommand = []() { return WQ.pop({.blocking = true}); };
- for(WQ_Entry entry = nextCommand(); entry.Command != COMMAND_EXIT; entry = nextCommand())
+ for(;;)
  {
-  WQ_Entry* wqe = &entry;
+  // The entry is only released after it's processed so WQ.waitForSize(0) also waits for queued lines to be composed
+  auto span = WQ.beginRead(1, {.blocking = true});
+
+  if(span.empty())
+   continue;
+
+  const WQ_Entry* wqe = &span[0];
+
+  if(wqe->Command == COMMAND_DRAW_LINE)
+  {
+   if(!espec->skip)
+    PrepLine(LineQueue[LineQueueCount++], (uint16)wqe->Arg32, wqe->Arg32 >> 16, wqe->Arg16);
+
+   // Keep batching only while the emulation thread is ahead of us, the span's
+   // cached write index may be stale so query the current size
+   if(LineQueueCount == LineQueueSize || !NumBandThreads || WQ.size() == 1)
+    FlushLines();
+
+   WQ.endRead(span);
+   WQ.notifyRead();
+   continue;
+  }
+
+  FlushLines();
+
+  if(wqe->Command == COMMAND_EXIT)
+  {
+   WQ.endRead(span);
+   break;
+  }
 
   switch(wqe->Command)
   {
@@ -3237,12 +3419,6 @@ static int RThreadEntry(void* data)
 	MemW<uint16>(wqe->Arg32, wqe->Arg16);
 	break;
 
-   case COMMAND_DRAW_LINE:
-	//for(unsigned i = 0; i < 2; i++)
-	DrawLine((uint16)wqe->Arg32, wqe->Arg32 >> 16, wqe->Arg16);
-	//
-	break;
-
    case COMMAND_RESET:
 	Reset(wqe->Arg32);
 	break;
@@ -3255,6 +3431,7 @@ static int RThreadEntry(void* data)
   //
   //
 
+  WQ.endRead(span);
   WQ.notifyRead();
  }
  WQ.notifyRead();
@@ -3267,7 +3444,7 @@ static int RThreadEntry(void* data)
 //
 //
 //
-void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
+void VDP2REND_Init(const bool IsPAL, const uint64 affinity, const unsigned threads)
 {
  PAL = IsPAL;
  VisibleLines = PAL ? 288 : 240;
@@ -3276,9 +3453,36 @@ void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
  Clock28M = false;
  //
  WQ.clear();
+ LineQueueCount = 0;
  RThread = MThreading::Thread_Create(RThreadEntry, NULL, "MDFN VDP2 Render");
  if(affinity)
   MThreading::Thread_SetAffinity(RThread, affinity);
+
+ // threads counts the render thread itself, 0 picks a count from the number of CPUs
+ unsigned total_threads = threads;
+
+ if(!total_threads)
+  total_threads = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+
+ NumBandThreads = std::min<unsigned>(total_threads - 1, VDP2REND_MaxBandThreads);
+ BandExit = false;
+
+ if(NumBandThreads)
+ {
+  BandStartSem = MThreading::Sem_Create();
+  BandDoneSem = MThreading::Sem_Create();
+
+  for(unsigned i = 0; i < NumBandThreads; i++)
+   BandThreads[i] = MThreading::Thread_Create(BandThreadEntry, (void*)(uintptr_t)i, "MDFN VDP2 Band");
+
+  for(unsigned i = 0; i < NumBandThreads; i++)
+   MThreading::Sem_Wait(BandDoneSem);
+ }
+}
+
+std::span<const IG::ThreadId> VDP2REND_GetBandThreadIds(void)
+{
+ return {BandThreadIds.data(), NumBandThreads};
 }
 
 // Needed for ss.correct_aspect == 0
@@ -3348,6 +3552,27 @@ void VDP2REND_Kill(void)
   RThread = NULL;
   RThreadId = {};
  }
+
+ if(NumBandThreads)
+ {
+  BandExit = true;
+
+  for(unsigned i = 0; i < NumBandThreads; i++)
+   MThreading::Sem_Post(BandStartSem);
+
+  for(unsigned i = 0; i < NumBandThreads; i++)
+  {
+   MThreading::Thread_Wait(BandThreads[i], NULL);
+   BandThreads[i] = NULL;
+   BandThreadIds[i] = {};
+  }
+
+  MThreading::Sem_Destroy(BandStartSem);
+  MThreading::Sem_Destroy(BandDoneSem);
+  BandStartSem = NULL;
+  BandDoneSem = NULL;
+  NumBandThreads = 0;
+ }
 }
 
 void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, const int SurfInterlaceField)
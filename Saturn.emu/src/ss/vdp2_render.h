@@ -22,12 +22,19 @@
 #ifndef __MDFN_SS_VDP2_RENDER_H
 #define __MDFN_SS_VDP2_RENDER_H
 
+#include <imagine/thread/Thread.hh>
+#include <span>
+
 namespace MDFN_IEN_SS
 {
 
-void VDP2REND_Init(const bool IsPAL, const uint64 affinity) MDFN_COLD;
+enum : unsigned { VDP2REND_MaxBandThreads = 7 };
+
+void VDP2REND_Init(const bool IsPAL, const uint64 affinity, const unsigned threads) MDFN_COLD;
 void VDP2REND_SetGetVideoParams(MDFNGI* gi, const bool caspect, const int sls, const int sle, const bool show_h_overscan, const bool dohblend) MDFN_COLD;
 void VDP2REND_Kill(void) MDFN_COLD;
+// IDs of the band threads started by VDP2REND_Init(), all are set once it returns
+std::span<const IG::ThreadId> VDP2REND_GetBandThreadIds(void);
 void VDP2REND_GetGunXTranslation(const bool clock28m, float* scale, float* offs);
 void VDP2REND_StartFrame(EmulateSpecStruct* espec, const bool clock28m, const int SurfInterlaceField);
 void VDP2REND_EndFrame(void);
@@ -73,6 +73,8 @@ bool access(CStringView path, acc type);
 bool remove(CStringView path);
 bool create_directory(CStringView path);
 bool rename(CStringView oldPath, CStringView newPath);
+// sets the last write time to now
+bool touch(CStringView path);
 
 PathString makeAppPathFromLaunchCommand(CStringView launchPath);
 FileString basename(CStringView path);
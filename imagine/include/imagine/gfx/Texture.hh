@@ -46,7 +46,10 @@ struct TextureWriteFlags
 {
 	uint8_t
 	async:1{},
-	makeMipmaps:1{};
+	makeMipmaps:1{},
+	// only upload rows that differ from the previous upload, if the texture supports it,
+	// currently only system memory storage since it requires reading back the buffer
+	skipUnchangedRows:1{};
 };
 
 struct TextureBufferFlags
@@ -50,7 +50,13 @@ public:
 protected:
 	int8_t bufferIdx{};
 	std::array<BufferInfo, 2> info{};
+	// copy of the last upload, used to find changed rows when there's no second buffer (system memory only)
+	std::unique_ptr<char[]> lastUploadData;
+	bool prevRowsAreValid{};
 	static constexpr int8_t SINGLE_BUFFER_VALUE = 2;
+	static constexpr int maxRowSpans = 8;
+
+	void unlockChangedRows(LockedTextureBuffer, TextureWriteFlags);
 
 	BufferInfo currentBuffer() const
 	{
@@ -78,6 +84,7 @@ public:
 	constexpr GLSystemMemoryStorage() = default;
 	GLSystemMemoryStorage(RendererTask&, TextureConfig, TextureBufferImageMode);
 	void initBuffer(PixmapDesc, TextureBufferImageMode);
+	static constexpr bool canCompareRows = true;
 
 private:
 	std::unique_ptr<char[]> storage;
@@ -97,6 +104,7 @@ public:
 	constexpr GLPixelBufferStorage() = default;
 	GLPixelBufferStorage(RendererTask&, TextureConfig, TextureBufferImageMode);
 	void initBuffer(PixmapDesc, TextureBufferImageMode);
+	static constexpr bool canCompareRows = false;
 	GLuint pbo() const { return pixelBuff.get(); }
 
 private:
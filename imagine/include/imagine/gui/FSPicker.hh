@@ -25,6 +25,7 @@
 #include <imagine/thread/WorkThread.hh>
 #include <imagine/util/DelegateFunc.hh>
 #include <imagine/util/string/CStringView.hh>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -47,17 +48,13 @@ public:
 	using OnSelectPathDelegate = DelegateFunc<void (FSPicker &, CStringView filePath, std::string_view displayName, const Input::Event &)>;
 	enum class Mode : uint8_t { FILE, FILE_IN_DIR, DIR };
 
+	// Entries only hold their names, menu items are bound to the visible rows on demand
 	struct FileEntry
 	{
-		static constexpr auto isDirFlag = bit(0);
-
 		std::string path;
-		TextMenuItem text;
-
-		FileEntry(ViewAttachParams attach, auto &&path, UTF16Convertible auto &&name):
-			path{IG_forward(path)}, text{IG_forward(name), attach} {}
-		bool isDir() const { return text.flags.user & isDirFlag; }
-		TextMenuItem &menuItem() { return text; }
+		std::string name;
+		bool isDir{};
+		bool isActive{true};
 	};
 
 	enum class DepthMode { increment, decrement, reset };
@@ -93,6 +90,10 @@ protected:
 	OnChangePathDelegate onChangePath_;
 	OnSelectPathDelegate onSelectPath_;
 	std::vector<FileEntry> dir;
+	std::vector<FileEntry> pendingDir;
+	std::mutex pendingDirMutex;
+	std::vector<TextMenuItem> rowItems;
+	std::vector<size_t> rowItemEntryIdx;
 	std::vector<TableUIState> fileUIStates;
 	FS::RootedPath root;
 	Gfx::Text msgText;
@@ -100,6 +101,7 @@ protected:
 	TableUIState newFileUIState{};
 	Mode mode_{};
 	bool showHiddenFiles_{};
+	bool restoreUIStatePending{};
 	WorkThread dirListThread{};
 
 	void changeDirByInput(CStringView path, FS::RootPathInfo, const Input::Event &,
@@ -109,6 +111,11 @@ protected:
 	TableView &fileTableView();
 	void startDirectoryListThread(CStringView path);
 	void listDirectory(CStringView path, ThreadStop &stop);
+	void queueEntries(std::vector<FileEntry> &);
+	void mergePendingEntries();
+	TextMenuItem &rowItem(size_t idx);
+	void selectEntry(size_t idx, const Input::Event &);
+	void resizeRowItems();
 	void setEmptyPath(std::string_view message);
 };
 
@@ -23,6 +23,7 @@
 #include <imagine/util/concepts.hh>
 #include <imagine/util/variant.hh>
 #include <string_view>
+#include <utility>
 
 namespace IG::Input
 {
@@ -83,6 +84,9 @@ public:
 	void resetName(UTF16Convertible auto &&name) { nameStr = IG_forward(name); }
 	void resetName() { nameStr.clear(); }
 	void resetItemSource(ItemSourceDelegate src = [](ItemMessage) -> ItemReply { return 0uz; }) { itemSrc = src; }
+	// only place and prepare the cells currently in view, for item sources that bind items on demand
+	void setPlaceVisibleItemsOnly(bool on) { placeVisibleItemsOnly = on; }
+	std::pair<size_t, size_t> visibleCellRange() const;
 
 protected:
 	static constexpr size_t maxSeparators = 32;
@@ -98,6 +102,7 @@ protected:
 	bool onlyScrollIfNeeded = false;
 	bool selectedIsActivated = false;
 	bool hasFocus = true;
+	bool placeVisibleItemsOnly = false;
 
 	void setYCellSize(int s);
 	WRect focusRect();
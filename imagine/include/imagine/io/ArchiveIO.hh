@@ -56,6 +56,10 @@ public:
 	std::string_view name() const;
 	FS::file_type type() const;
 	uint32_t crc32() const;
+	// entry is stored without compression, like a stored zip entry
+	bool isStored() const;
+	// archive format can compress entries together, so reading one may decode the ones before it
+	bool isSolidFormat() const;
 	bool readNextEntry();
 	bool hasEntry() const;
 	bool hasArchive() const { return arch.get(); }
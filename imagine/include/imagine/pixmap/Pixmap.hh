@@ -41,6 +41,19 @@ uint32_t transformRGB565ToBGRX8888(uint16_t p);
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p);
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p);
 
+// batch versions of the above, vectorized where the target supports it
+void transformRGB565ToRGB888(RGBTripleArray *dest, size_t pixels, const uint16_t *src);
+void transformRGB888ToRGB565(uint16_t *dest, size_t pixels, const RGBTripleArray *src);
+void transformRGBA8888ToBGRA8888(uint32_t *dest, size_t pixels, const uint32_t *src);
+void transformRGBX8888ToRGB565(uint16_t *dest, size_t pixels, const uint32_t *src);
+void transformBGRX8888ToRGB565(uint16_t *dest, size_t pixels, const uint32_t *src);
+void transformRGBX8888ToRGB888(RGBTripleArray *dest, size_t pixels, const uint32_t *src);
+void transformBGRX8888ToRGB888(RGBTripleArray *dest, size_t pixels, const uint32_t *src);
+void transformRGB565ToRGBX8888(uint32_t *dest, size_t pixels, const uint16_t *src);
+void transformRGB565ToBGRX8888(uint32_t *dest, size_t pixels, const uint16_t *src);
+void transformRGB888ToRGBX8888(uint32_t *dest, size_t pixels, const RGBTripleArray *src);
+void transformRGB888ToBGRX8888(uint32_t *dest, size_t pixels, const RGBTripleArray *src);
+
 template <class Func>
 concept PixmapTransformFunc =
 		requires (Func &&f, unsigned data){ f(data); } ||
@@ -367,6 +380,28 @@ protected:
 		}
 	}
 
+	template <class Src, class Dest>
+	void writeConvertedLines(void(*lineFunc)(Dest*, size_t, const Src*), auto pixmap) requires(dataIsMutable)
+	{
+		auto srcData = (const Src*)pixmap.data();
+		auto destData = (Dest*)data_;
+		if(w() == pixmap.w() && !isPadded() && !pixmap.isPadded())
+		{
+			lineFunc(destData, pixmap.w() * pixmap.h(), srcData);
+		}
+		else
+		{
+			auto srcPitchPixels = pixmap.pitchPx();
+			auto destPitchPixels = pitchPx();
+			for([[maybe_unused]] auto h : iotaCount(pixmap.h()))
+			{
+				lineFunc(destData, pixmap.w(), srcData);
+				srcData += srcPitchPixels;
+				destData += destPitchPixels;
+			}
+		}
+	}
+
 	static void invalidFormatConversion([[maybe_unused]] auto dest, [[maybe_unused]] auto src)
 	{
 		bug_unreachable("unimplemented conversion:%s -> %s", src.format().name(), dest.format().name());
@@ -374,57 +409,57 @@ protected:
 
 	static void convertRGB888ToRGBX8888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<RGBTripleArray, uint32_t>(transformRGB888ToRGBX8888, src);
+		dest.template writeConvertedLines<RGBTripleArray, uint32_t>(transformRGB888ToRGBX8888, src);
 	}
 
 	static void convertRGB888ToBGRX8888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<RGBTripleArray, uint32_t>(transformRGB888ToBGRX8888, src);
+		dest.template writeConvertedLines<RGBTripleArray, uint32_t>(transformRGB888ToBGRX8888, src);
 	}
 
 	static void convertRGB565ToRGBX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToRGBX8888, src);
+		dest.template writeConvertedLines<uint16_t, uint32_t>(transformRGB565ToRGBX8888, src);
 	}
 
 	static void convertRGB565ToBGRX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToBGRX8888, src);
+		dest.template writeConvertedLines<uint16_t, uint32_t>(transformRGB565ToBGRX8888, src);
 	}
 
 	static void convertRGBX8888ToRGB888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<uint32_t, RGBTripleArray>(transformRGBX8888ToRGB888, src);
+		dest.template writeConvertedLines<uint32_t, RGBTripleArray>(transformRGBX8888ToRGB888, src);
 	}
 
 	static void convertBGRX8888ToRGB888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<uint32_t, RGBTripleArray>(transformBGRX8888ToRGB888, src);
+		dest.template writeConvertedLines<uint32_t, RGBTripleArray>(transformBGRX8888ToRGB888, src);
 	}
 
 	static void convertRGB565ToRGB888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<uint16_t, RGBTripleArray>(transformRGB565ToRGB888, src);
+		dest.template writeConvertedLines<uint16_t, RGBTripleArray>(transformRGB565ToRGB888, src);
 	}
 
 	static void convertRGB888ToRGB565(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<RGBTripleArray, uint16_t>(transformRGB888ToRGB565, src);
+		dest.template writeConvertedLines<RGBTripleArray, uint16_t>(transformRGB888ToRGB565, src);
 	}
 
 	static void convertRGBX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBX8888ToRGB565, src);
+		dest.template writeConvertedLines<uint32_t, uint16_t>(transformRGBX8888ToRGB565, src);
 	}
 
 	static void convertRGBA8888ToBGRA8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBA8888ToBGRA8888, src);
+		dest.template writeConvertedLines<uint32_t, uint32_t>(transformRGBA8888ToBGRA8888, src);
 	}
 
 	static void convertBGRX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformBGRX8888ToRGB565, src);
+		dest.template writeConvertedLines<uint32_t, uint16_t>(transformBGRX8888ToRGB565, src);
 	}
 };
 
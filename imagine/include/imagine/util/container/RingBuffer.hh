@@ -18,6 +18,7 @@
 #include <imagine/vmem/memory.hh>
 #include <imagine/util/math.hh>
 #include <imagine/util/algorithm.h>
+#include <algorithm>
 #include <cstdint>
 #include <cassert>
 #include <atomic>
@@ -72,6 +73,7 @@ public:
 	{
 		writeIdx.store(0, std::memory_order_relaxed);
 		readIdx.store(0, std::memory_order_relaxed);
+		cachedReadIdx = cachedWriteIdx = 0;
 	}
 
 	[[nodiscard]]
@@ -104,16 +106,23 @@ public:
 	[[nodiscard]]
 	bool full() const { return size() == capacity(); }
 
+	// Reserves up to s contiguous elements for reading, only reloading the producer's
+	// index when the last seen value doesn't cover the request. Non-mirrored buffers
+	// return a shorter span at the wrap point so a batch may take two calls.
 	[[nodiscard]]
 	RWSpan beginRead(size_t s, RWFlags flags = {})
 	{
-		IdxPair idxs{.read = readIdx.load(std::memory_order_relaxed), .write = writeIdx.load(std::memory_order_acquire)};
-		if(flags.blocking && empty(idxs))
+		IdxPair idxs{.read = readIdx.load(std::memory_order_relaxed), .write = cachedWriteIdx};
+		if(size(idxs) < s)
 		{
-			writeIdx.wait(idxs.write, std::memory_order_acquire);
-			idxs.write = writeIdx.load(std::memory_order_acquire);
+			idxs.write = cachedWriteIdx = writeIdx.load(std::memory_order_acquire);
+			if(flags.blocking && empty(idxs))
+			{
+				writeIdx.wait(idxs.write, std::memory_order_acquire);
+				idxs.write = cachedWriteIdx = writeIdx.load(std::memory_order_acquire);
+			}
 		}
-		s = std::min(s, size(idxs));
+		s = std::min({s, size(idxs), contiguousSize(idxs.read)});
 		std::span<T> span{&buff[wrapIdx(idxs.read)], s};
 		assertAddrRange(span);
 		return {span, idxs};
@@ -126,10 +135,19 @@ public:
 
 	size_t read(std::span<T> buff, RWFlags flags = {})
 	{
-		auto span = beginRead(buff.size(), flags);
-		copy_n(span.data(), span.size(), buff.data());
-		endRead(span);
-		return span.size();
+		size_t readSize{};
+		while(buff.size())
+		{
+			auto span = beginRead(buff.size(), flags);
+			if(span.empty())
+				break;
+			copy_n(span.data(), span.size(), buff.data());
+			endRead(span);
+			readSize += span.size();
+			buff = buff.subspan(span.size());
+			flags.blocking = false;
+		}
+		return readSize;
 	}
 
 	[[nodiscard]]
@@ -154,17 +172,23 @@ public:
 		readIdx.notify_all();
 	}
 
+	// Reserves up to s contiguous elements for writing, with the same caching
+	// and wrap behavior as beginRead()
 	[[nodiscard]]
 	RWSpan beginWrite(size_t s, RWFlags flags = {})
 	{
-		IdxPair idxs{.read = readIdx.load(std::memory_order_acquire), .write = writeIdx.load(std::memory_order_relaxed)};
-		if(flags.blocking && !freeSpace(idxs))
+		IdxPair idxs{.read = cachedReadIdx, .write = writeIdx.load(std::memory_order_relaxed)};
+		if(freeSpace(idxs) < s)
 		{
-			notifyWrite();
-			readIdx.wait(idxs.read, std::memory_order_acquire);
-			idxs.read = readIdx.load(std::memory_order_acquire);
+			idxs.read = cachedReadIdx = readIdx.load(std::memory_order_acquire);
+			if(flags.blocking && !freeSpace(idxs))
+			{
+				notifyWrite();
+				readIdx.wait(idxs.read, std::memory_order_acquire);
+				idxs.read = cachedReadIdx = readIdx.load(std::memory_order_acquire);
+			}
 		}
-		s = std::min(s, freeSpace(idxs));
+		s = std::min({s, freeSpace(idxs), contiguousSize(idxs.write)});
 		std::span<T> span{&buff[wrapIdx(idxs.write)], s};
 		assertAddrRange(span);
 		return {span, idxs};
@@ -177,12 +201,25 @@ public:
 
 	size_t write(std::span<const T> buff, RWFlags flags = {})
 	{
-		auto span = beginWrite(buff.size(), flags);
-		copy_n(buff.data(), span.size(), span.data());
-		endWrite(span);
-		if(flags.flushSize && (size() + span.size() >= flags.flushSize))
-			notifyWrite();
-		return span.size();
+		size_t writeSize{};
+		while(buff.size())
+		{
+			auto span = beginWrite(buff.size(), flags);
+			if(span.empty())
+				break;
+			copy_n(buff.data(), span.size(), span.data());
+			endWrite(span);
+			writeSize += span.size();
+			buff = buff.subspan(span.size());
+			flags.blocking = false;
+		}
+		if(flags.flushSize)
+		{
+			IdxPair idxs{.read = cachedReadIdx = readIdx.load(std::memory_order_acquire), .write = writeIdx.load(std::memory_order_relaxed)};
+			if(size(idxs) + writeSize >= flags.flushSize)
+				notifyWrite();
+		}
+		return writeSize;
 	}
 
 	bool push(const T& val, RWFlags flags = {})
@@ -238,8 +275,11 @@ private:
 	static_assert(conf.fixedSize == 0 || std::has_single_bit(conf.fixedSize));
 	static_assert(conf.fixedSize == 0 || (conf.fixedSize > 0 && !conf.mirrored));
 	std::conditional_t<isFixedSize, std::array<T, conf.fixedSize>, UniqueVPtr<T>> buff;
+	// each side's index shares a cache line with its private copy of the other side's index
 	alignas(idxAlign) std::atomic_size_t writeIdx{};
+	size_t cachedReadIdx{}; // producer only
 	alignas(idxAlign) std::atomic_size_t readIdx{};
+	size_t cachedWriteIdx{}; // consumer only
 
 	static UniqueVPtr<T> allocBuffer(size_t size) requires(!isFixedSize)
 	{
@@ -257,6 +297,11 @@ private:
 		return s & (capacity() - 1);
 	}
 
+	size_t contiguousSize(size_t idx) const
+	{
+		return conf.mirrored ? capacity() : capacity() - wrapIdx(idx);
+	}
+
 	IdxPair loadIdxs() const
 	{
 		return {.read = readIdx.load(std::memory_order_acquire), .write = writeIdx.load(std::memory_order_acquire)};
@@ -43,7 +43,8 @@ inline size_t uncompressGzip(std::span<uint8_t> dest, std::span<const uint8_t> s
 	s.next_in = const_cast<z_const Bytef*>(src.data());
 	s.avail_out = dest.size();
 	s.next_out = dest.data();
-  inflateInit2(&s, MAX_WBITS + 16);
+  if(inflateInit2(&s, MAX_WBITS + 16) != Z_OK)
+		return 0;
   auto res = inflate(&s, Z_FINISH);
   inflateEnd(&s);
 	if(res != Z_STREAM_END)
@@ -18,32 +18,159 @@
 #include <imagine/util/algorithm.h>
 #include <imagine/util/math.hh>
 #include <cmath>
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
 
 namespace IG::Audio
 {
 
-static int16_t remapToInt16(float x)
+static int16_t remapClampToInt16(float x)
 {
-	assumeExpr(x >= -1.f && x <= 1.f);
-	return remap(x, -1.f, 1.f, std::numeric_limits<int16_t>{});
+	return remapClamp(x, -1.f, 1.f, std::numeric_limits<int16_t>{});
 }
 
-static int16_t remapClampToInt16(float x)
+// Vector kernels handle blocks of 8 samples and return the number processed,
+// the scalar loops below finish any remainder
+#if defined __SSE2__
+static size_t convertI16SamplesToFloatVec(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
 {
-	return remapClamp(x, -1.f, 1.f, std::numeric_limits<int16_t>{});
+	const auto scale = _mm_set1_ps(volume / 32768.f);
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto s = _mm_loadu_si128((const __m128i*)src);
+		auto lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+		auto hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+		_mm_storeu_ps(dest, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+		_mm_storeu_ps(dest + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+	}
+	return blocks * 8;
+}
+
+static __m128i floatToI16Lane(__m128 s, __m128 volume)
+{
+	// same mapping as remapClampToInt16()
+	s = _mm_min_ps(_mm_max_ps(_mm_mul_ps(s, volume), _mm_set1_ps(-1.f)), _mm_set1_ps(1.f));
+	s = _mm_sub_ps(_mm_mul_ps(s, _mm_set1_ps(32767.5f)), _mm_set1_ps(.5f));
+	return _mm_cvttps_epi32(s);
+}
+
+static size_t convertFloatSamplesToI16Vec(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = _mm_set1_ps(volume);
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto lo = floatToI16Lane(_mm_loadu_ps(src), vol);
+		auto hi = floatToI16Lane(_mm_loadu_ps(src + 4), vol);
+		_mm_storeu_si128((__m128i*)dest, _mm_packs_epi32(lo, hi));
+	}
+	return blocks * 8;
+}
+
+static size_t scaleI16SamplesVec(int16_t * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const auto vol = _mm_set1_ps(volume / 32768.f);
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto s = _mm_loadu_si128((const __m128i*)src);
+		auto lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+		auto hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+		_mm_storeu_si128((__m128i*)dest, _mm_packs_epi32(floatToI16Lane(lo, vol), floatToI16Lane(hi, vol)));
+	}
+	return blocks * 8;
 }
 
+static size_t scaleFloatSamplesVec(float * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = _mm_set1_ps(volume);
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		_mm_storeu_ps(dest, _mm_mul_ps(_mm_loadu_ps(src), vol));
+		_mm_storeu_ps(dest + 4, _mm_mul_ps(_mm_loadu_ps(src + 4), vol));
+	}
+	return blocks * 8;
+}
+#elif defined __ARM_NEON
+static size_t convertI16SamplesToFloatVec(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const float scale = volume / 32768.f;
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto s = vld1q_s16(src);
+		vst1q_f32(dest, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), scale));
+		vst1q_f32(dest + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale));
+	}
+	return blocks * 8;
+}
+
+static int16x4_t floatToI16Lane(float32x4_t s, float volume)
+{
+	// same mapping as remapClampToInt16()
+	s = vminq_f32(vmaxq_f32(vmulq_n_f32(s, volume), vdupq_n_f32(-1.f)), vdupq_n_f32(1.f));
+	s = vsubq_f32(vmulq_n_f32(s, 32767.5f), vdupq_n_f32(.5f));
+	return vqmovn_s32(vcvtq_s32_f32(s));
+}
+
+static size_t convertFloatSamplesToI16Vec(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		vst1q_s16(dest, vcombine_s16(floatToI16Lane(vld1q_f32(src), volume), floatToI16Lane(vld1q_f32(src + 4), volume)));
+	}
+	return blocks * 8;
+}
+
+static size_t scaleI16SamplesVec(int16_t * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const float vol = volume / 32768.f;
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto s = vld1q_s16(src);
+		auto lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+		auto hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+		vst1q_s16(dest, vcombine_s16(floatToI16Lane(lo, vol), floatToI16Lane(hi, vol)));
+	}
+	return blocks * 8;
+}
+
+static size_t scaleFloatSamplesVec(float * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	size_t blocks = samples / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		vst1q_f32(dest, vmulq_n_f32(vld1q_f32(src), volume));
+		vst1q_f32(dest + 4, vmulq_n_f32(vld1q_f32(src + 4), volume));
+	}
+	return blocks * 8;
+}
+#else
+static size_t convertI16SamplesToFloatVec(float*, size_t, const int16_t*, float) { return 0; }
+static size_t convertFloatSamplesToI16Vec(int16_t*, size_t, const float*, float) { return 0; }
+static size_t scaleI16SamplesVec(int16_t*, size_t, const int16_t*, float) { return 0; }
+static size_t scaleFloatSamplesVec(float*, size_t, const float*, float) { return 0; }
+#endif
+
 static float *convertI16SamplesToFloat(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
 {
+	auto vecSamples = convertI16SamplesToFloatVec(dest, samples, src, volume);
+	dest += vecSamples; src += vecSamples; samples -= vecSamples;
 	return transformN(src, samples, dest, [=](int16_t s){ return (float(s) / 32768.f) * volume; });
 }
 
 static int16_t *convertFloatSamplesToI16(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
 {
-	if(volume <= 1.f)
-		return transformN(src, samples, dest, [=](float s){ return remapToInt16(s * volume); });
-	else
-		return transformN(src, samples, dest, [=](float s){ return remapClampToInt16(s * volume); });
+	auto vecSamples = convertFloatSamplesToI16Vec(dest, samples, src, volume);
+	dest += vecSamples; src += vecSamples; samples -= vecSamples;
+	return transformN(src, samples, dest, [=](float s){ return remapClampToInt16(s * volume); });
 }
 
 static int16_t *copyI16Samples(int16_t * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
@@ -54,10 +181,9 @@ static int16_t *copyI16Samples(int16_t * __restrict__ dest, size_t samples, cons
 	}
 	else
 	{
-		if(volume <= 1.f)
-			return transformN(src, samples, dest, [=](int16_t s){ return remapToInt16((float(s) / 32768.f) * volume); });
-		else
-			return transformN(src, samples, dest, [=](int16_t s){ return remapClampToInt16((float(s) / 32768.f) * volume); });
+		auto vecSamples = scaleI16SamplesVec(dest, samples, src, volume);
+		dest += vecSamples; src += vecSamples; samples -= vecSamples;
+		return transformN(src, samples, dest, [=](int16_t s){ return remapClampToInt16((float(s) / 32768.f) * volume); });
 	}
 }
 
@@ -69,6 +195,8 @@ static float *copyFloatSamples(float * __restrict__ dest, size_t samples, const
 	}
 	else
 	{
+		auto vecSamples = scaleFloatSamplesVec(dest, samples, src, volume);
+		dest += vecSamples; src += vecSamples; samples -= vecSamples;
 		return transformN(src, samples, dest, [=](float s){ return s * volume; });
 	}
 }
@@ -22,6 +22,7 @@
 #endif
 #include <cerrno>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <cstdlib>
 #include <cstring>
 #include <system_error>
@@ -340,4 +341,15 @@ bool rename(CStringView oldPath, CStringView newPath)
 	return true;
 }
 
+bool touch(CStringView path)
+{
+	if(::utimensat(AT_FDCWD, path, nullptr, 0) == -1) [[unlikely]]
+	{
+		if(Config::DEBUG_BUILD)
+			logErr("utimensat(%s) error:%s", path.data(), strerror(errno));
+		return false;
+	}
+	return true;
+}
+
 }
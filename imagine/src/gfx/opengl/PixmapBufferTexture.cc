@@ -24,6 +24,7 @@
 #endif
 #include <imagine/logger/logger.h>
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
 
 #ifndef GL_MAP_WRITE_BIT
@@ -244,6 +245,8 @@ template<class Impl, class BufferInfo>
 bool GLTextureStorage<Impl, BufferInfo>::setFormat(PixmapDesc desc, ColorSpace colorSpace, TextureSamplerConfig samplerConf)
 {
 	static_cast<Impl*>(this)->initBuffer(desc, imageMode());
+	lastUploadData.reset();
+	prevRowsAreValid = false;
 	return Texture::setFormat(desc, 1, colorSpace, samplerConf);
 }
 
@@ -271,16 +274,89 @@ LockedTextureBuffer GLTextureStorage<Impl, BufferInfo>::lock(TextureBufferFlags
 template<class Impl, class BufferInfo>
 void GLTextureStorage<Impl, BufferInfo>::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 {
-	Texture::unlock(lockBuff, writeFlags);
+	// comparing rows reads back the locked buffer, which is only valid for system memory since
+	// mapped PBOs are write-only
+	if(Impl::canCompareRows && writeFlags.skipUnchangedRows && lockBuff)
+	{
+		unlockChangedRows(lockBuff, writeFlags);
+		prevRowsAreValid = true;
+	}
+	else
+	{
+		Texture::unlock(lockBuff, writeFlags);
+		// with two buffers the one just uploaded always matches the texture
+		prevRowsAreValid = buffers() == 2;
+	}
 	swapBuffer();
 }
 
+template<class Impl, class BufferInfo>
+void GLTextureStorage<Impl, BufferInfo>::unlockChangedRows(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
+{
+	auto pix = lockBuff.pixmap();
+	const auto pitchBytes = pix.pitchBytes();
+	const auto rowBytes = pix.format().pixelBytes(pix.w());
+	// compare against the previous buffer if double buffered, otherwise against a copy of the last upload
+	char *prevData;
+	if(buffers() == 2)
+	{
+		prevData = (char*)info[(bufferIdx + 1) % 2].data;
+	}
+	else
+	{
+		if(!lastUploadData)
+		{
+			lastUploadData = std::make_unique<char[]>(pix.bytes());
+			prevRowsAreValid = false;
+		}
+		prevData = lastUploadData.get();
+	}
+	if(!prevRowsAreValid)
+	{
+		if(buffers() == 1)
+			std::copy_n(pix.data(), pix.bytes(), prevData);
+		Texture::unlock(lockBuff, writeFlags);
+		return;
+	}
+	std::array<std::pair<int, int>, maxRowSpans> spans;
+	int spanCount = 0;
+	for(int y = 0; y < pix.h(); y++)
+	{
+		auto rowData = pix.data() + y * pitchBytes;
+		auto prevRowData = prevData + y * pitchBytes;
+		if(std::memcmp(rowData, prevRowData, rowBytes) == 0)
+			continue;
+		if(buffers() == 1)
+			std::copy_n(rowData, rowBytes, prevRowData);
+		if(spanCount && (spans[spanCount - 1].second == y || spanCount == maxRowSpans))
+			spans[spanCount - 1].second = y + 1; // extend the last span, possibly over unchanged rows once out of spans
+		else
+			spans[spanCount++] = {y, y + 1};
+	}
+	for(int i = 0; i < spanCount; i++)
+	{
+		auto [y1, y2] = spans[i];
+		auto spanFlags = writeFlags;
+		spanFlags.makeMipmaps = writeFlags.makeMipmaps && i == spanCount - 1;
+		if(y1 == 0 && y2 == pix.h())
+		{
+			Texture::unlock(lockBuff, spanFlags);
+			return;
+		}
+		LockedTextureBuffer rowsBuff{(char*)lockBuff.bufferOffset() + y1 * pitchBytes,
+			pix.subView({0, y1}, {pix.w(), y2 - y1}), {{0, y1}, {pix.w(), y2}},
+			lockBuff.level(), false, lockBuff.pbo()};
+		Texture::unlock(rowsBuff, spanFlags);
+	}
+}
+
 template<class Impl, class BufferInfo>
 void GLTextureStorage<Impl, BufferInfo>::writeAligned(PixmapView pixmap, int assumeAlign, TextureWriteFlags writeFlags)
 {
 	if(renderer().support.hasUnpackRowLength || !pixmap.isPadded())
 	{
 		Texture::writeAligned(0, pixmap, {}, assumeAlign, writeFlags);
+		prevRowsAreValid = false; // texture no longer matches either buffer
 	}
 	else
 	{
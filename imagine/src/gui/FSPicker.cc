@@ -18,13 +18,19 @@
 #include <imagine/gui/TextEntry.hh>
 #include <imagine/gui/NavView.hh>
 #include <imagine/fs/FS.hh>
+#include <imagine/io/FileIO.hh>
 #include <imagine/base/ApplicationContext.hh>
+#include <imagine/time/Time.hh>
 #include <imagine/gfx/RendererCommands.hh>
 #include <imagine/gfx/BasicEffect.hh>
 #include <imagine/logger/logger.h>
 #include <imagine/util/math.hh>
 #include <imagine/util/format.hh>
+#include <imagine/util/ranges.hh>
 #include <imagine/util/string.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <string>
 #include <system_error>
 
@@ -32,6 +38,126 @@ namespace IG
 {
 
 constexpr SystemLogger log{"FSPicker"};
+// entries are sorted and handed to the UI in batches of this size while listing
+constexpr size_t dirListBatchSize = 512;
+// directories with at least this many entries get an index in the cache directory
+constexpr size_t dirIndexMinEntries = 1000;
+// only index directories whose write time is at least this old
+constexpr Seconds dirIndexMinAge{2};
+constexpr size_t minRowItems = 32;
+constexpr char dirIndexMagic[8]{'F', 'S', 'I', 'D', 'X', '0', '0', '1'};
+
+static bool entryIsBefore(const FSPicker::FileEntry &e1, const FSPicker::FileEntry &e2)
+{
+	if(e1.isDir && !e2.isDir)
+		return true;
+	else if(!e1.isDir && e2.isDir)
+		return false;
+	else
+		return caselessLexCompare(e1.path, e2.path);
+}
+
+struct DirIndexEntry
+{
+	std::string path;
+	std::string name;
+	FS::file_type type;
+};
+
+static FS::PathString dirIndexPath(ApplicationContext ctx, std::string_view dirPath)
+{
+	uint64_t hash = 0xcbf29ce484222325; // FNV-1a
+	for(auto c : dirPath)
+	{
+		hash = (hash ^ uint8_t(c)) * 0x100000001b3;
+	}
+	return FS::pathString(FS::createDirectorySegments(ctx.cachePath(), "dirindex"), std::format("{:016x}", hash));
+}
+
+// Index layout: magic, directory write time, directory path, entry count,
+// then each entry's type, name and path, all sizes in native byte order
+static std::vector<DirIndexEntry> readDirIndex(ApplicationContext ctx, std::string_view dirPath, int64_t dirTime)
+{
+	FileIO io{dirIndexPath(ctx, dirPath), {.test = true, .accessHint = IOAccessHint::All}};
+	if(!io)
+		return {};
+	auto buff = io.buffer(IOBufferMode::Direct);
+	std::span<const uint8_t> data{buff.data(), buff.size()};
+	auto get = [&](auto &val)
+	{
+		if(data.size() < sizeof(val))
+			return false;
+		memcpy(&val, data.data(), sizeof(val));
+		data = data.subspan(sizeof(val));
+		return true;
+	};
+	auto getString = [&](std::string &str)
+	{
+		uint32_t size;
+		if(!get(size) || data.size() < size)
+			return false;
+		str.assign(reinterpret_cast<const char*>(data.data()), size);
+		data = data.subspan(size);
+		return true;
+	};
+	char magic[8];
+	int64_t indexDirTime;
+	std::string indexDirPath;
+	uint32_t count;
+	if(!get(magic) || memcmp(magic, dirIndexMagic, sizeof(magic))
+		|| !get(indexDirTime) || indexDirTime != dirTime
+		|| !getString(indexDirPath) || indexDirPath != dirPath
+		|| !get(count) || count > data.size())
+	{
+		return {};
+	}
+	std::vector<DirIndexEntry> entries;
+	entries.reserve(count);
+	for([[maybe_unused]] auto i : iotaCount(count))
+	{
+		uint8_t type;
+		auto &e = entries.emplace_back();
+		if(!get(type) || !getString(e.name) || !getString(e.path))
+			return {};
+		e.type = FS::file_type(type);
+	}
+	log.info("using index for:{} with {} entries", dirPath, entries.size());
+	return entries;
+}
+
+static void writeDirIndex(ApplicationContext ctx, std::string_view dirPath, int64_t dirTime, const std::vector<DirIndexEntry> &entries)
+{
+	auto path = dirIndexPath(ctx, dirPath);
+	auto tempPath = FS::PathString{path}.append(".tmp");
+	try
+	{
+		std::string data;
+		auto put = [&](auto val) { data.append(reinterpret_cast<const char*>(&val), sizeof(val)); };
+		auto putString = [&](std::string_view str) { put(uint32_t(str.size())); data.append(str); };
+		data.append(dirIndexMagic, sizeof(dirIndexMagic));
+		put(dirTime);
+		putString(dirPath);
+		put(uint32_t(entries.size()));
+		for(const auto &e : entries)
+		{
+			put(uint8_t(e.type));
+			putString(e.name);
+			putString(e.path);
+		}
+		{
+			FileIO io{tempPath, OpenFlags::newFile()};
+			if(io.write(data.data(), data.size()) != ssize_t(data.size()))
+				throw std::runtime_error("short write");
+		}
+		if(!FS::rename(tempPath, path))
+			throw std::runtime_error("can't rename");
+	}
+	catch(std::exception &err)
+	{
+		log.error("error writing index for:{}: {}", dirPath, err.what());
+		FS::remove(tempPath);
+	}
+}
 
 FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::TextureSpan closeRes,
 	FilterFunc filter, Mode mode, Gfx::GlyphTextureSet *face_):
@@ -73,19 +199,117 @@ FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::Textu
 			pushFileLocationsView(e);
 		});
 	controller.setNavView(std::move(nav));
-	controller.push(makeView<TableView>(dir));
+	auto table = makeView<TableView>(
+		[this](TableView::ItemMessage msg)
+		{
+			return msg.visit(overloaded
+			{
+				[&](const TableView::ItemsMessage&) -> TableView::ItemReply { return dir.size(); },
+				[&](const TableView::GetItemMessage& m) -> TableView::ItemReply { return &rowItem(m.idx); },
+			});
+		});
+	table->setPlaceVisibleItemsOnly(true);
+	controller.push(std::move(table));
 	controller.navView()->showLeftBtn(true);
 	dir.reserve(16); // start with some initial capacity to avoid small reallocations
 }
 
 void FSPicker::place()
 {
+	resizeRowItems();
 	controller.place(viewRect(), displayRect());
 	if(dirListThread.isWorking())
 		return;
 	msgText.compile();
 }
 
+void FSPicker::resizeRowItems()
+{
+	// enough row items for every visible cell plus the neighbors used by key navigation
+	auto cellYSize = makeEvenRoundedUp(manager().defaultFace.nominalHeight() * 2);
+	auto rows = std::max(cellYSize > 0 ? size_t(divRoundUp(displayRect().ySize(), cellYSize)) + 4 : 0, minRowItems);
+	if(rows <= rowItems.size())
+		return;
+	rowItems.reserve(rows);
+	while(rowItems.size() < rows)
+	{
+		rowItems.emplace_back(UTF16String{}, attachParams());
+	}
+	rowItemEntryIdx.assign(rows, SIZE_MAX);
+}
+
+TextMenuItem &FSPicker::rowItem(size_t idx)
+{
+	if(rowItems.empty()) [[unlikely]]
+		resizeRowItems();
+	auto slot = idx % rowItems.size();
+	auto &item = rowItems[slot];
+	if(rowItemEntryIdx[slot] == idx)
+		return item;
+	rowItemEntryIdx[slot] = idx;
+	auto &entry = dir[idx];
+	item.setName(entry.name);
+	item.setActive(entry.isActive);
+	item.onSelect = [this, idx](const Input::Event &e) { selectEntry(idx, e); };
+	item.place();
+	return item;
+}
+
+void FSPicker::selectEntry(size_t idx, const Input::Event &e)
+{
+	auto &entry = dir[idx];
+	if(!entry.isActive)
+		return;
+	if(entry.isDir)
+	{
+		assert(!isSingleDirectoryMode());
+		auto path = entry.path; // copy since changing directories clears the entries
+		log.info("entering dir:{}", path);
+		changeDirByInput(path, root.info, e);
+	}
+	else
+	{
+		onSelectPath_.callCopy(*this, entry.path, appContext().fileUriDisplayName(entry.path), e);
+	}
+}
+
+void FSPicker::queueEntries(std::vector<FileEntry> &batch)
+{
+	std::ranges::sort(batch, entryIsBefore);
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		auto mid = pendingDir.size();
+		pendingDir.insert(pendingDir.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+		std::inplace_merge(pendingDir.begin(), pendingDir.begin() + mid, pendingDir.end(), entryIsBefore);
+	}
+	batch.clear();
+	dirListEvent.notify();
+}
+
+void FSPicker::mergePendingEntries()
+{
+	std::vector<FileEntry> entries;
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		entries = std::exchange(pendingDir, {});
+	}
+	if(entries.empty())
+		return;
+	// keep the same entry highlighted by shifting it past the new entries sorted before it,
+	// the merge is stable so new entries comparing equal land after it
+	auto selected = fileTableView().highlightedCell();
+	size_t selectedShift{};
+	if(selected >= 0 && size_t(selected) < dir.size())
+		selectedShift = std::ranges::lower_bound(entries, dir[selected], entryIsBefore) - entries.begin();
+	// batches arrive sorted so merging keeps the whole list sorted without re-sorting it
+	auto mid = dir.size();
+	dir.insert(dir.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+	std::inplace_merge(dir.begin(), dir.begin() + mid, dir.end(), entryIsBefore);
+	std::ranges::fill(rowItemEntryIdx, SIZE_MAX);
+	if(selectedShift)
+		fileTableView().highlightCell(selected + int(selectedShift));
+}
+
 void FSPicker::changeDirByInput(CStringView path, FS::RootPathInfo rootInfo, const Input::Event &e,
 	DepthMode depthMode)
 {
@@ -180,13 +404,12 @@ void FSPicker::prepareDraw()
 
 void FSPicker::draw(Gfx::RendererCommands &__restrict__ cmds, ViewDrawParams) const
 {
-	if(!dirListThread.isWorking())
+	if(dir.size()) // entries are shown as they stream in
+	{
+		controller.top().draw(cmds);
+	}
+	else if(!dirListThread.isWorking())
 	{
-		if(dir.size())
-		{
-			controller.top().draw(cmds);
-		}
-		else
 		{
 			using namespace IG::Gfx;
 			cmds.basicEffect().enableAlphaTexture(cmds);
@@ -210,6 +433,8 @@ void FSPicker::setEmptyPath(std::string_view message)
 	newFileUIState = {};
 	fileUIStates.clear();
 	dir.clear();
+	pendingDir.clear();
+	std::ranges::fill(rowItemEntryIdx, SIZE_MAX);
 	msgText.resetString(message);
 	if(mode_ == Mode::FILE_IN_DIR)
 	{
@@ -467,16 +692,20 @@ void FSPicker::startDirectoryListThread(CStringView path)
 		});
 		return;
 	}
+	dirListEvent.cancel();
+	// the previous listing thread has stopped so nothing else can be queued
 	dir.clear();
-	fileTableView().resetItemSource();
+	pendingDir.clear();
+	std::ranges::fill(rowItemEntryIdx, SIZE_MAX);
+	restoreUIStatePending = true;
 	dirListEvent.setCallback([this]()
 	{
-		fileTableView().resetItemSource(dir);
+		mergePendingEntries();
 		place();
-		fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
+		if(!dirListThread.isWorking() && std::exchange(restoreUIStatePending, false))
+			fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
 		postDraw();
 	});
-	dirListEvent.cancel();
 	dirListThread.reset([this](WorkThread::Context ctx, const std::string &path)
 	{
 		listDirectory(path, ctx.stop);
@@ -489,74 +718,73 @@ void FSPicker::startDirectoryListThread(CStringView path)
 
 void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 {
+	auto ctx = appContext();
+	std::vector<FileEntry> batch;
+	batch.reserve(dirListBatchSize);
+	size_t entries{};
+	auto addEntry = [&](const FS::directory_entry &entry)
+	{
+		bool isDir = entry.type() == FS::file_type::directory;
+		if(mode_ == Mode::FILE_IN_DIR && isDir) // filter directories
+			return;
+		if(!showHiddenFiles_ && entry.name().starts_with('.'))
+			return;
+		if(filter && !filter(entry))
+			return;
+		batch.emplace_back(std::string{entry.path()}, std::string{entry.name()}, isDir, mode_ != Mode::DIR || isDir);
+		entries++;
+		if(batch.size() == dirListBatchSize)
+			queueEntries(batch);
+	};
 	try
 	{
-		appContext().forEachInDirectoryUri(path,
-			[this, &stop](auto &entry)
+		auto dirTimePoint = ctx.fileUriLastWriteTime(path);
+		auto dirTime = dirTimePoint.time_since_epoch().count();
+		auto index = dirTime ? readDirIndex(ctx, path, dirTime) : std::vector<DirIndexEntry>{};
+		if(index.size())
+		{
+			for(const auto &e : index)
 			{
-				//log.info("entry:{}", entry.path());
 				if(stop) [[unlikely]]
 				{
 					log.info("interrupted listing directory");
-					return false;
+					return;
 				}
-				bool isDir = entry.type() == FS::file_type::directory;
-				if(mode_ == Mode::FILE_IN_DIR) // filter directories
-				{
-					if(isDir)
-						return true;
-				}
-				if(!showHiddenFiles_ && entry.name().starts_with('.'))
-				{
-					return true;
-				}
-				if(filter && !filter(entry))
-				{
-					return true;
-				}
-				auto &item = dir.emplace_back(attachParams(), std::string{entry.path()}, entry.name());
-				if(isDir)
-					item.text.flags.user |= FileEntry::isDirFlag;
-				if(mode_ == Mode::DIR && !isDir)
-					item.text.setActive(false);
-				return true;
-			});
-		std::ranges::sort(dir,
-			[](const FileEntry &e1, const FileEntry &e2)
-			{
-				if(e1.isDir() && !e2.isDir())
-					return true;
-				else if(!e1.isDir() && e2.isDir())
-					return false;
-				else
-					return caselessLexCompare(e1.path, e2.path);
-			});
-		if(dir.size())
+				addEntry(FS::directory_entry{e.path, e.name, e.type});
+			}
+		}
+		else
 		{
-			for(auto &d : dir)
+			std::vector<DirIndexEntry> newIndex;
+			auto onEntry = [&](const FS::directory_entry &entry)
 			{
-				if(!d.text.active())
-					continue;
-				if(d.isDir())
-				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							assert(!isSingleDirectoryMode());
-							auto path = std::move(dirPath);
-							log.info("entering dir:{}", path);
-							changeDirByInput(path, root.info, e);
-						};
-				}
-				else
+				newIndex.emplace_back(std::string{entry.path()}, std::string{entry.name()}, entry.type());
+				addEntry(entry);
+			};
+			ctx.forEachInDirectoryUri(path,
+				[&stop, &onEntry](auto &entry)
 				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							onSelectPath_.callCopy(*this, dirPath, appContext().fileUriDisplayName(dirPath), e);
-						};
-				}
-			}
+					//log.info("entry:{}", entry.path());
+					if(stop) [[unlikely]]
+					{
+						log.info("interrupted listing directory");
+						return false;
+					}
+					onEntry(entry);
+					return true;
+				});
+			if(stop)
+				return;
+			// some providers only report the write time in whole seconds, so a directory modified
+			// just now could change again without its time changing and leave a stale index
+			bool dirTimeIsSettled = WallClock::now() - dirTimePoint >= dirIndexMinAge;
+			if(dirTime && dirTimeIsSettled && newIndex.size() >= dirIndexMinEntries)
+				writeDirIndex(ctx, path, dirTime, newIndex);
+		}
+		if(batch.size())
+			queueEntries(batch);
+		if(entries)
+		{
 			msgText.resetString();
 		}
 		else // no entries, show a message instead
@@ -61,12 +61,23 @@ void TableView::setAlign(_2DOrigin align)
 void TableView::prepareDraw()
 {
 	auto src = itemSrc;
-	for(auto i : iotaCount(cells()))
+	auto [startCell, endCell] = placeVisibleItemsOnly ? visibleCellRange() : std::pair{0uz, cells()};
+	for(auto i = startCell; i < endCell; i++)
 	{
 		item(src, i).prepareDraw();
 	}
 }
 
+std::pair<size_t, size_t> TableView::visibleCellRange() const
+{
+	ssize_t cells_ = cells();
+	if(!cells_ || !yCellSize)
+		return {};
+	ssize_t startYCell = std::clamp(ssize_t(scrollOffset() / yCellSize), 0z, cells_);
+	ssize_t endYCell = std::clamp(startYCell + visibleCells, 0z, cells_);
+	return {startYCell, endYCell};
+}
+
 void TableView::draw(Gfx::RendererCommands &__restrict__ cmds, ViewDrawParams) const
 {
 	ssize_t cells_ = cells();
@@ -173,10 +184,13 @@ void TableView::place()
 {
 	auto cells_ = cells();
 	auto src = itemSrc;
-	for(auto i : iotaCount(cells_))
+	if(!placeVisibleItemsOnly)
 	{
-		//log.debug("place item:{}", i);
-		item(src, i).place();
+		for(auto i : iotaCount(cells_))
+		{
+			//log.debug("place item:{}", i);
+			item(src, i).place();
+		}
 	}
 	if(cells_)
 	{
@@ -184,6 +198,14 @@ void TableView::place()
 		visibleCells = IG::divRoundUp(displayRect().ySize(), yCellSize) + 1;
 		scrollToFocusRect();
 		selectQuads.write(0, {.bounds = WRect{{}, {viewRect().xSize(), yCellSize-1}}.as<int16_t>()});
+		if(placeVisibleItemsOnly)
+		{
+			auto [startCell, endCell] = visibleCellRange();
+			for(auto i = startCell; i < endCell; i++)
+			{
+				item(src, i).place();
+			}
+		}
 	}
 	else
 		visibleCells = 0;
@@ -207,6 +207,21 @@ uint32_t ArchiveIO::crc32() const
 	return archive_entry_crc32(ptr);
 }
 
+bool ArchiveIO::isStored() const
+{
+	assumeExpr(ptr);
+	// the zip reader names the format per entry, e.g. "ZIP 1.0 (uncompressed)"
+	auto formatName = archive_format_name(arch.get());
+	return (archive_format(arch.get()) & ARCHIVE_FORMAT_BASE_MASK) == ARCHIVE_FORMAT_ZIP && formatName
+		&& std::string_view{formatName}.contains("uncompressed");
+}
+
+bool ArchiveIO::isSolidFormat() const
+{
+	auto format = archive_format(arch.get()) & ARCHIVE_FORMAT_BASE_MASK;
+	return format == ARCHIVE_FORMAT_7ZIP || format == ARCHIVE_FORMAT_RAR || format == ARCHIVE_FORMAT_RAR_V5;
+}
+
 bool ArchiveIO::readNextEntry()
 {
 	if(!arch) [[unlikely]]
@@ -13,8 +13,16 @@
 	You should have received a copy of the GNU General Public License
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <imagine/util/algorithm.h>
 #include <array>
 #include <cstdint>
+#include <cstddef>
+#include <utility>
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
 
 namespace IG
 {
@@ -109,4 +117,247 @@ static uint32_t transformRGB888ToRGBX8888Impl(RGBTripleArray p)
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl(p); }
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl<true>(p); }
 
+// Vector kernels handle blocks of 8 pixels and return the number processed,
+// the scalar loops below finish any remainder. Results match the per-pixel
+// functions above exactly, the divisions by 31, 63 and 255 are done with
+// multiply/shift sequences that are exact over each channel's input range.
+#if defined __SSE2__
+template <bool BGR_SWAP>
+static size_t transformRGB565ToRGBX8888Vec(uint32_t * __restrict__ dest, size_t pixels, const uint16_t * __restrict__ src)
+{
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto p = _mm_loadu_si128((const __m128i*)src);
+		auto r = _mm_srli_epi16(p, 11);
+		auto g = _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F));
+		auto b = _mm_and_si128(p, _mm_set1_epi16(0x1F));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		// (x * 255 + 15) / 31 and (x * 255 + 31) / 63
+		r = _mm_srli_epi16(_mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(255)), _mm_set1_epi16(15)), _mm_set1_epi16(4229)), 1);
+		b = _mm_srli_epi16(_mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(255)), _mm_set1_epi16(15)), _mm_set1_epi16(4229)), 1);
+		g = _mm_srli_epi16(_mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(g, _mm_set1_epi16(255)), _mm_set1_epi16(31)), _mm_set1_epi16(4161)), 2);
+		auto rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+		_mm_storeu_si128((__m128i*)dest, _mm_unpacklo_epi16(rg, b));
+		_mm_storeu_si128((__m128i*)(dest + 4), _mm_unpackhi_epi16(rg, b));
+	}
+	return blocks * 8;
+}
+
+static __m128i div255Lane(__m128i x)
+{
+	// exact for x < 65535
+	return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+template <bool BGR_SWAP>
+static size_t transformRGBX8888ToRGB565Vec(uint16_t * __restrict__ dest, size_t pixels, const uint32_t * __restrict__ src)
+{
+	const auto mask = _mm_set1_epi32(0xFF);
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto p0 = _mm_loadu_si128((const __m128i*)src);
+		auto p1 = _mm_loadu_si128((const __m128i*)(src + 4));
+		auto r = _mm_packs_epi32(_mm_and_si128(p0, mask), _mm_and_si128(p1, mask));
+		auto g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), mask), _mm_and_si128(_mm_srli_epi32(p1, 8), mask));
+		auto b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), mask), _mm_and_si128(_mm_srli_epi32(p1, 16), mask));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		// (x * 31 + 127) / 255 and (x * 63 + 127) / 255
+		r = div255Lane(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(31)), _mm_set1_epi16(127)));
+		g = div255Lane(_mm_add_epi16(_mm_mullo_epi16(g, _mm_set1_epi16(63)), _mm_set1_epi16(127)));
+		b = div255Lane(_mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(31)), _mm_set1_epi16(127)));
+		auto out = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+		_mm_storeu_si128((__m128i*)dest, out);
+	}
+	return blocks * 8;
+}
+
+static size_t transformRGBA8888ToBGRA8888Vec(uint32_t * __restrict__ dest, size_t pixels, const uint32_t * __restrict__ src)
+{
+	const auto agMask = _mm_set1_epi32(int(0xFF00FF00));
+	const auto mask = _mm_set1_epi32(0xFF);
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		for(size_t j = 0; j < 8; j += 4)
+		{
+			auto p = _mm_loadu_si128((const __m128i*)(src + j));
+			auto out = _mm_or_si128(_mm_and_si128(p, agMask),
+				_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 16), mask), _mm_slli_epi32(_mm_and_si128(p, mask), 16)));
+			_mm_storeu_si128((__m128i*)(dest + j), out);
+		}
+	}
+	return blocks * 8;
+}
+
+// RGB888 conversions need byte shuffles beyond SSE2 and are left to the scalar loops
+template <bool BGR_SWAP>
+static size_t transformRGBX8888ToRGB888Vec(RGBTripleArray*, size_t, const uint32_t*) { return 0; }
+template <bool BGR_SWAP>
+static size_t transformRGB888ToRGBX8888Vec(uint32_t*, size_t, const RGBTripleArray*) { return 0; }
+#elif defined __ARM_NEON
+static uint16x8_t mulhiLane(uint16x8_t x, uint16_t mul)
+{
+	auto lo = vshrn_n_u32(vmull_n_u16(vget_low_u16(x), mul), 16);
+	auto hi = vshrn_n_u32(vmull_n_u16(vget_high_u16(x), mul), 16);
+	return vcombine_u16(lo, hi);
+}
+
+template <bool BGR_SWAP>
+static size_t transformRGB565ToRGBX8888Vec(uint32_t * __restrict__ dest, size_t pixels, const uint16_t * __restrict__ src)
+{
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto p = vld1q_u16(src);
+		auto r = vshrq_n_u16(p, 11);
+		auto g = vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F));
+		auto b = vandq_u16(p, vdupq_n_u16(0x1F));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		// (x * 255 + 15) / 31 and (x * 255 + 31) / 63
+		r = vshrq_n_u16(mulhiLane(vmlaq_n_u16(vdupq_n_u16(15), r, 255), 4229), 1);
+		b = vshrq_n_u16(mulhiLane(vmlaq_n_u16(vdupq_n_u16(15), b, 255), 4229), 1);
+		g = vshrq_n_u16(mulhiLane(vmlaq_n_u16(vdupq_n_u16(31), g, 255), 4161), 2);
+		auto rgb = vzipq_u16(vorrq_u16(r, vshlq_n_u16(g, 8)), b);
+		vst1q_u32(dest, vreinterpretq_u32_u16(rgb.val[0]));
+		vst1q_u32(dest + 4, vreinterpretq_u32_u16(rgb.val[1]));
+	}
+	return blocks * 8;
+}
+
+static uint16x8_t div255Lane(uint16x8_t x)
+{
+	// exact for x < 65535
+	return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+template <bool BGR_SWAP>
+static size_t transformRGBX8888ToRGB565Vec(uint16_t * __restrict__ dest, size_t pixels, const uint32_t * __restrict__ src)
+{
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto p = vld4_u8((const uint8_t*)src);
+		if constexpr(BGR_SWAP) { std::swap(p.val[0], p.val[2]); }
+		// (x * 31 + 127) / 255 and (x * 63 + 127) / 255
+		auto r = div255Lane(vmlaq_n_u16(vdupq_n_u16(127), vmovl_u8(p.val[0]), 31));
+		auto g = div255Lane(vmlaq_n_u16(vdupq_n_u16(127), vmovl_u8(p.val[1]), 63));
+		auto b = div255Lane(vmlaq_n_u16(vdupq_n_u16(127), vmovl_u8(p.val[2]), 31));
+		vst1q_u16(dest, vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b));
+	}
+	return blocks * 8;
+}
+
+static size_t transformRGBA8888ToBGRA8888Vec(uint32_t * __restrict__ dest, size_t pixels, const uint32_t * __restrict__ src)
+{
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto p = vld4_u8((const uint8_t*)src);
+		std::swap(p.val[0], p.val[2]);
+		vst4_u8((uint8_t*)dest, p);
+	}
+	return blocks * 8;
+}
+
+template <bool BGR_SWAP>
+static size_t transformRGBX8888ToRGB888Vec(RGBTripleArray * __restrict__ dest, size_t pixels, const uint32_t * __restrict__ src)
+{
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto p = vld4_u8((const uint8_t*)src);
+		if constexpr(BGR_SWAP) { std::swap(p.val[0], p.val[2]); }
+		vst3_u8((uint8_t*)dest, uint8x8x3_t{{p.val[0], p.val[1], p.val[2]}});
+	}
+	return blocks * 8;
+}
+
+template <bool BGR_SWAP>
+static size_t transformRGB888ToRGBX8888Vec(uint32_t * __restrict__ dest, size_t pixels, const RGBTripleArray * __restrict__ src)
+{
+	size_t blocks = pixels / 8;
+	for(size_t i = 0; i < blocks; i++, src += 8, dest += 8)
+	{
+		auto p = vld3_u8((const uint8_t*)src);
+		// the first source byte ends up in the third channel, see transformRGB888ToRGBX8888Impl()
+		if constexpr(!BGR_SWAP) { std::swap(p.val[0], p.val[2]); }
+		vst4_u8((uint8_t*)dest, uint8x8x4_t{{p.val[0], p.val[1], p.val[2], vdup_n_u8(0)}});
+	}
+	return blocks * 8;
+}
+#else
+template <bool BGR_SWAP>
+static size_t transformRGB565ToRGBX8888Vec(uint32_t*, size_t, const uint16_t*) { return 0; }
+template <bool BGR_SWAP>
+static size_t transformRGBX8888ToRGB565Vec(uint16_t*, size_t, const uint32_t*) { return 0; }
+static size_t transformRGBA8888ToBGRA8888Vec(uint32_t*, size_t, const uint32_t*) { return 0; }
+template <bool BGR_SWAP>
+static size_t transformRGBX8888ToRGB888Vec(RGBTripleArray*, size_t, const uint32_t*) { return 0; }
+template <bool BGR_SWAP>
+static size_t transformRGB888ToRGBX8888Vec(uint32_t*, size_t, const RGBTripleArray*) { return 0; }
+#endif
+
+static void transformPixels(auto * __restrict__ dest, size_t pixels, const auto * __restrict__ src, auto vecFunc, auto func)
+{
+	auto vecPixels = vecFunc(dest, pixels, src);
+	transformN(src + vecPixels, pixels - vecPixels, dest + vecPixels, func);
+}
+
+void transformRGB565ToRGB888(RGBTripleArray *dest, size_t pixels, const uint16_t *src)
+{
+	transformN(src, pixels, dest, [](uint16_t p){ return transformRGB565ToRGB888(p); });
+}
+
+void transformRGB888ToRGB565(uint16_t *dest, size_t pixels, const RGBTripleArray *src)
+{
+	transformN(src, pixels, dest, [](RGBTripleArray p){ return transformRGB888ToRGB565(p); });
+}
+
+void transformRGBA8888ToBGRA8888(uint32_t *dest, size_t pixels, const uint32_t *src)
+{
+	transformPixels(dest, pixels, src, transformRGBA8888ToBGRA8888Vec, [](uint32_t p){ return transformRGBA8888ToBGRA8888(p); });
+}
+
+void transformRGBX8888ToRGB565(uint16_t *dest, size_t pixels, const uint32_t *src)
+{
+	transformPixels(dest, pixels, src, transformRGBX8888ToRGB565Vec<false>, transformRGBX8888ToRGB565Impl<false>);
+}
+
+void transformBGRX8888ToRGB565(uint16_t *dest, size_t pixels, const uint32_t *src)
+{
+	transformPixels(dest, pixels, src, transformRGBX8888ToRGB565Vec<true>, transformRGBX8888ToRGB565Impl<true>);
+}
+
+void transformRGBX8888ToRGB888(RGBTripleArray *dest, size_t pixels, const uint32_t *src)
+{
+	transformPixels(dest, pixels, src, transformRGBX8888ToRGB888Vec<false>, transformRGBX8888ToRGB888Impl<false>);
+}
+
+void transformBGRX8888ToRGB888(RGBTripleArray *dest, size_t pixels, const uint32_t *src)
+{
+	transformPixels(dest, pixels, src, transformRGBX8888ToRGB888Vec<true>, transformRGBX8888ToRGB888Impl<true>);
+}
+
+void transformRGB565ToRGBX8888(uint32_t *dest, size_t pixels, const uint16_t *src)
+{
+	transformPixels(dest, pixels, src, transformRGB565ToRGBX8888Vec<false>, transformRGB565ToRGBX8888Impl<false>);
+}
+
+void transformRGB565ToBGRX8888(uint32_t *dest, size_t pixels, const uint16_t *src)
+{
+	transformPixels(dest, pixels, src, transformRGB565ToRGBX8888Vec<true>, transformRGB565ToRGBX8888Impl<true>);
+}
+
+void transformRGB888ToRGBX8888(uint32_t *dest, size_t pixels, const RGBTripleArray *src)
+{
+	transformPixels(dest, pixels, src, transformRGB888ToRGBX8888Vec<false>, transformRGB888ToRGBX8888Impl<false>);
+}
+
+void transformRGB888ToBGRX8888(uint32_t *dest, size_t pixels, const RGBTripleArray *src)
+{
+	transformPixels(dest, pixels, src, transformRGB888ToRGBX8888Vec<true>, transformRGB888ToRGBX8888Impl<true>);
+}
+
 }